@@ -0,0 +1,57 @@
+#version 430 core
+
+layout (location = 0) in vec3 aPos;     // Vertex position
+layout (location = 1) in vec3 aNormal;  // Normals
+layout (location = 2) in vec3 aColor;   // Vertex color
+layout (location = 3) in vec2 aTex;     // Texture Coordinates
+layout (location = 4) in mat4 aModel;   // Per-instance model matrix (4-7)
+layout (location = 8) in mat3 aNormalMatrix; // Per-instance normal matrix (8-10)
+layout (location = 11) in uint aDraw;    // Per-instance draw command index
+
+out vec3 currPos;      // Pass the current position
+out vec3 normalWS;     // Pass normal to fragment shader
+out vec3 vertexColor;  // Pass color to fragment shader
+out vec2 texCoord;     // Pass texture coordinates to fragment shader
+flat out ivec2 materialLayers; // Diffuse and specular layers of the material array
+
+// Per-frame camera and light data, shared by every scene program
+layout (std140) uniform FrameData {
+    mat4 camMatrix;      // proj * view
+    vec4 camPos;         // xyz
+    vec4 lightColor;     // rgb, intensity applied
+    vec4 lightDir;       // xyz
+    float ambient;       // Ambient strength
+    float skyboxExposure;
+};
+
+// Material layers of each draw command, filled by MeshBatch
+layout (std430, binding = 0) readonly buffer DrawMaterials {
+    uvec2 drawLayers[];
+};
+
+
+void main() {
+    // local values
+    vec4 localPos = vec4(aPos, 1.0f);
+    vec3 localNormal = aNormal;
+
+    // transform into world space
+    vec4 worldPos = aModel * localPos;
+    currPos = worldPos.xyz;
+
+    // assign the normal from model space to world space
+#ifdef GPU_NORMAL_MATRIX
+    mat3 normalMat = mat3(transpose(inverse(aModel)));
+#else
+    mat3 normalMat = aNormalMatrix;
+#endif
+    normalWS = normalize(normalMat * localNormal);
+
+    // pass color and tex coords
+    vertexColor = aColor;
+    texCoord = aTex;
+    materialLayers = ivec2(drawLayers[aDraw]);
+
+    // final clip-space position
+    gl_Position = camMatrix * worldPos;
+}
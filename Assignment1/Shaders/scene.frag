@@ -4,34 +4,84 @@ in vec3 currPos;       // Receive the current position
 in vec3 normalWS;		// Receive world space normal
 in vec3 vertexColor;   // Receive color from vertex shader
 in vec2 texCoord;      // Receive texture coordinates from vertex shader
+flat in ivec2 materialLayers; // Texture array layers, or -1 for diffuse0 / specular0
 
 out vec4 fragColor;
 
 uniform bool useTextures = true; // Toggle texture usage
 uniform sampler2D diffuse0; // texture unit for diffuse
 uniform sampler2D specular0; // texture unit for specular
+uniform sampler2DArray materialArray; // batched draws' material layers
 uniform float uvScale = 1.0;
 
-uniform vec4 lightColor; // Gets the color of the light
-uniform vec3 lightDir;   // Gets the direction of the light
-uniform vec3 camPos; // Gets the position of the camera
+// Per-frame camera and light data, shared by every scene program
+layout (std140) uniform FrameData {
+    mat4 camMatrix;      // proj * view
+    vec4 camPos;         // xyz
+    vec4 lightColor;     // rgb, intensity applied
+    vec4 lightDir;       // xyz
+    float ambient;       // Ambient strength
+    float skyboxExposure;
+};
+
+// Clustered point and spot lights, filled by ClusteredLights each frame
+layout (std140) uniform ClusterData {
+    vec4 clusterGrid;    // tiles x, tiles y, depth slices, 1 if enabled
+    vec4 clusterDepth;   // near plane, slices / log(far / near)
+    vec4 cameraForward;  // xyz
+};
+uniform samplerBuffer lightData;       // 3 texels per light: pos + range,
+                                       // color + cone outer cos, dir + inner cos
+uniform usamplerBuffer clusterRanges;  // first index, count per cluster
+uniform usamplerBuffer lightIndices;   // into lightData
 
-uniform float ambient; // Ambient strength
 uniform float specularStr = 5.0f; // Specular strength
 uniform float shininess = 32.0f; // Shininess factor
 
+// Blinn-Phong from every light in this fragment's cluster
+vec3 clusterLighting(vec3 N, vec3 V, vec3 baseColor, float specularMap) {
+    if (clusterGrid.w == 0.0) return vec3(0.0);
+
+    // Same cluster the CPU assigned: screen tile, then exponential slice
+    vec4 clip = camMatrix * vec4(currPos, 1.0);
+    ivec2 tiles = ivec2(clusterGrid.xy);
+    ivec2 tile = clamp(ivec2(floor((clip.xy / clip.w * 0.5 + 0.5) * clusterGrid.xy)), ivec2(0), tiles - 1);
+    float depth = max(dot(currPos - camPos.xyz, cameraForward.xyz), clusterDepth.x);
+    int slice = clamp(int(log(depth / clusterDepth.x) * clusterDepth.y), 0, int(clusterGrid.z) - 1);
+    uvec2 range = texelFetch(clusterRanges, tile.x + tiles.x * (tile.y + tiles.y * slice)).xy;
+
+    vec3 total = vec3(0.0);
+    for (uint i = 0u; i < range.y; ++i) {
+        int light = int(texelFetch(lightIndices, int(range.x + i)).r) * 3;
+        vec4 posRange = texelFetch(lightData, light);
+        vec4 colorOuter = texelFetch(lightData, light + 1);
+        vec4 dirInner = texelFetch(lightData, light + 2);
+
+        vec3 toLight = posRange.xyz - currPos;
+        float dist = length(toLight);
+        vec3 L = toLight / max(dist, 1e-4);
+
+        // Inverse square, windowed to reach zero at the range
+        float window = clamp(1.0 - pow(dist / posRange.w, 4.0), 0.0, 1.0);
+        float attenuation = window * window / (1.0 + dist * dist);
+        // Spot cone (always 1 for point lights)
+        attenuation *= smoothstep(colorOuter.w, dirInner.w, dot(-L, dirInner.xyz));
+
+        float diffuse = max(dot(N, L), 0.0);
+        float spec = pow(max(dot(N, normalize(L + V)), 0.0), shininess);
+        total += (baseColor * diffuse + specularMap * specularStr * spec) * colorOuter.rgb * attenuation;
+    }
+    return total;
+}
+
 
 void main() {
     // Lighting Vectors
     vec3 N = normalize(normalWS);
-    vec3 L = normalize(-lightDir);
-    vec3 V = normalize(camPos - currPos);
+    vec3 L = normalize(-lightDir.xyz);
+    vec3 V = normalize(camPos.xyz - currPos);
     vec3 H = normalize(L + V);  // Halfway vector for Blinn-Phong
 
-    // Attenuation
-    //float distance = length(lightPos - currPos);
-    //float attenuation = 1.0 / (1.0 + 0.09 * distance + 0.032 * distance * distance);
-        
     // Diffuse
     float diffuse = max(dot(N, L), 0.0);
     
@@ -39,14 +89,16 @@ void main() {
     float spec = pow(max(dot(N, H), 0.0), shininess);
     float specular = specularStr * spec;
     
-    // Sample textures with fallback
-    vec4 baseColor = useTextures ? texture(diffuse0, texCoord * uvScale) : vec4(vertexColor, 1.0);
-    float specularMap = useTextures ? texture(specular0, texCoord * uvScale).r : 0.5;
+    // Sample textures with fallback; batched draws read the material array
+    vec2 uv = texCoord * uvScale;
+    vec4 baseColor = materialLayers.x >= 0 ? texture(materialArray, vec3(uv, materialLayers.x))
+                   : useTextures ? texture(diffuse0, uv) : vec4(vertexColor, 1.0);
+    float specularMap = materialLayers.y >= 0 ? texture(materialArray, vec3(uv, materialLayers.y)).r
+                      : useTextures ? texture(specular0, uv).r : 0.5;
     
     // Combine
     vec3 result = (baseColor.rgb * (ambient + diffuse) + specularMap * specular) * lightColor.rgb;
-
-    //result *= attenuation;  // Apply distance falloff
+    result += clusterLighting(N, V, baseColor.rgb, specularMap);
 
     fragColor = vec4(result, baseColor.a);
 }
@@ -9,12 +9,22 @@ out vec3 currPos;      // Pass the current position
 out vec3 normalWS;     // Pass normal to fragment shader
 out vec3 vertexColor;  // Pass color to fragment shader
 out vec2 texCoord;     // Pass texture coordinates to fragment shader
-
-// Imports the camera matrix from the main function
-uniform mat4 camMatrix;  // proj * view
+flat out ivec2 materialLayers; // Texture array layers; -1 for the 2D samplers
+
+// Per-frame camera and light data, shared by every scene program
+layout (std140) uniform FrameData {
+    mat4 camMatrix;      // proj * view
+    vec4 camPos;         // xyz
+    vec4 lightColor;     // rgb, intensity applied
+    vec4 lightDir;       // xyz
+    float ambient;       // Ambient strength
+    float skyboxExposure;
+};
 
 // Imports the model matrix from the main function
 uniform mat4 model;
+// transpose(inverse(mat3(model))), computed once per draw on the CPU
+uniform mat3 normalMatrix;
 
 
 void main() {
@@ -27,12 +37,18 @@ void main() {
     currPos = worldPos.xyz;
 
     // assign the normal from model space to world space
-    mat3 normalMatrix = mat3(transpose(inverse(model)));
-    normalWS = normalize(normalMatrix * localNormal);
+#ifdef GPU_NORMAL_MATRIX
+    // Only the normal-matrix benchmark builds this variant
+    mat3 normalMat = mat3(transpose(inverse(model)));
+#else
+    mat3 normalMat = normalMatrix;
+#endif
+    normalWS = normalize(normalMat * localNormal);
 
     // pass color and tex coords
     vertexColor = aColor;
     texCoord = aTex;
+    materialLayers = ivec2(-1);
 
     // final clip-space position
     gl_Position = camMatrix * worldPos;
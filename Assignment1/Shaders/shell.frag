@@ -0,0 +1,9 @@
+#version 330 core
+
+// Placeholder stage, see shell.vert
+
+out vec4 fragColor;
+
+void main() {
+    fragColor = vec4(0.0);
+}
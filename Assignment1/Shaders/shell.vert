@@ -0,0 +1,8 @@
+#version 330 core
+
+// Placeholder stage: the engine Shader can only be built from files, so
+// EngineShaderView builds one from this and points it at linked programs
+
+void main() {
+    gl_Position = vec4(0.0);
+}
@@ -4,7 +4,16 @@ in vec3 texDir;
 out vec4 fragColor;
 
 uniform samplerCube environmentMap;
-uniform float skyboxExposure = 1.0;
+
+// Per-frame camera and light data, shared by every scene program
+layout (std140) uniform FrameData {
+    mat4 camMatrix;      // proj * view
+    vec4 camPos;         // xyz
+    vec4 lightColor;     // rgb, intensity applied
+    vec4 lightDir;       // xyz
+    float ambient;       // Ambient strength
+    float skyboxExposure;
+};
 
 void main() {
     vec3 color = texture(environmentMap, texDir).rgb;
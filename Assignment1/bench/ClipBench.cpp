@@ -0,0 +1,161 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+// Compression ratio, error and decode speed of CompressedClip on a long
+// recorded flight, and memory use of streaming it back with StreamingClip.
+// Usage: clip_bench [seconds] [sample rate] [players]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "AnimationTrack.h"
+#include "CompressedClip.h"
+#include "StreamingClip.h"
+
+using Clock = std::chrono::steady_clock;
+
+static double secondsSince(Clock::time_point t0) {
+    return std::chrono::duration<double>(Clock::now() - t0).count();
+}
+
+// Smooth random flight: a Catmull-Rom key every two seconds
+static std::vector<Keyframe> makeFlight(float seconds, std::mt19937& rng) {
+    std::uniform_real_distribution<float> turn(-1.0f, 1.0f);
+    std::vector<Keyframe> keys;
+    glm::vec3 pos(0.0f), heading(0.0f, 0.0f, -1.0f);
+    for (float time = -2.0f; time <= seconds + 4.0f; time += 2.0f) {
+        heading = glm::normalize(heading + glm::vec3(turn(rng), 0.3f * turn(rng), turn(rng)) * 0.6f);
+        pos += heading * 40.0f;
+        keys.push_back({ pos, glm::quat(1, 0, 0, 0), time });
+    }
+    return keys;
+}
+
+int main(int argc, char** argv) {
+    float seconds      = argc > 1 ? (float)std::atof(argv[1]) : 600.0f;
+    float rate         = argc > 2 ? (float)std::atof(argv[2]) : 60.0f;
+    std::size_t players = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 10000;
+    if (seconds <= 0.0f || rate <= 0.0f || players == 0) return 1;
+
+    std::mt19937 rng(3);
+    AnimationTrack flight(makeFlight(seconds, rng));
+    std::vector<Keyframe> recorded = resampleTrack(flight, rate);
+    double rawPerSecond = sizeof(Keyframe) * rate;
+    std::cout << "[Bench] " << seconds << "s flight at " << rate << " Hz: " << recorded.size()
+              << " keys, " << rawPerSecond << " B/s raw\n";
+
+    const ClipCompressionSettings levels[] = { { 0.001f, 0.01f }, { 0.01f, 0.1f }, { 0.05f, 0.5f } };
+    for (const ClipCompressionSettings& settings : levels) {
+        auto t0 = Clock::now();
+        CompressedClip clip(recorded, settings);
+        double buildS = secondsSince(t0);
+
+        // Error against every recorded key
+        float posErr = 0.0f, rotErr = 0.0f;
+        std::size_t cursor = 0;
+        for (const Keyframe& k : recorded) {
+            glm::vec3 p;
+            glm::quat q;
+            clip.sample(k.time, cursor, p, q);
+            posErr = std::max(posErr, glm::length(p - k.position));
+            glm::quat r = glm::normalize(k.rotation);
+            if (glm::dot(q, r) < 0.0f) r = -r;
+            float chord = glm::length(glm::vec4(q.x - r.x, q.y - r.y, q.z - r.z, q.w - r.w));
+            rotErr = std::max(rotErr, glm::degrees(4.0f * std::asin(std::min(chord * 0.5f, 1.0f))));
+        }
+
+        double perSecond = clip.byteSize() / clip.duration();
+        std::cout << "[Bench] bound " << settings.positionError << " / " << settings.rotationError
+                  << " deg: " << clip.keyCount() << " keys, " << perSecond << " B/s ("
+                  << rawPerSecond / perSecond << "x), max error " << posErr << " / " << rotErr
+                  << " deg, build " << buildS * 1000.0 << " ms\n";
+    }
+
+    // Decode speed at the middle setting: many players, forward playback
+    CompressedClip clip(recorded, levels[1]);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::vector<float> times(players);
+    std::vector<std::size_t> cursors(players, 0);
+    for (float& t : times) t = clip.startTime() + unit(rng) * clip.duration();
+
+    const int frames = 120;
+    const float dt = 1.0f / 60.0f;
+    glm::vec3 sink(0.0f);
+    auto t0 = Clock::now();
+    for (int f = 0; f < frames; ++f) {
+        for (std::size_t i = 0; i < players; ++i) {
+            times[i] += dt;
+            if (times[i] > clip.endTime()) times[i] -= clip.duration();
+            glm::vec3 p;
+            glm::quat q;
+            clip.sample(times[i], cursors[i], p, q);
+            sink += p + glm::vec3(q.x, q.y, q.z);
+        }
+    }
+    double forwardNs = secondsSince(t0) * 1e9 / (double(players) * frames);
+
+    // Random access: every sample has to search
+    t0 = Clock::now();
+    for (int f = 0; f < frames; ++f) {
+        for (std::size_t i = 0; i < players; ++i) {
+            std::size_t cursor = 0;
+            glm::vec3 p;
+            glm::quat q;
+            clip.sample(clip.startTime() + unit(rng) * clip.duration(), cursor, p, q);
+            sink += p;
+        }
+    }
+    double randomNs = secondsSince(t0) * 1e9 / (double(players) * frames);
+
+    std::cout << "[Bench] Decode: " << forwardNs << " ns/sample forward, " << randomNs
+              << " ns/sample random access\n";
+
+    // Round trip through a file
+    bool saved = clip.save("clip_bench.rclip");
+    CompressedClip loaded;
+    bool roundTrip = saved && loaded.load("clip_bench.rclip") && loaded.keyCount() == clip.keyCount();
+    for (std::size_t i = 0; roundTrip && i < clip.keyCount(); ++i) {
+        Keyframe a = clip.key(i), b = loaded.key(i);
+        roundTrip = a.time == b.time && a.position == b.position && a.rotation == b.rotation;
+    }
+    std::cout << "[Bench] File round trip: " << (roundTrip ? "ok" : "FAILED") << "\n";
+
+    // Streamed playback of the same file at 60 fps: must match the loaded
+    // clip while holding only a few chunks
+    StreamingClip stream("clip_bench.rclip");
+    bool streamed = stream.isOpen() && stream.keyCount() == clip.keyCount();
+    std::size_t peakBytes = 0;
+    float streamErr = 0.0f;
+    ClipCursor streamCursor;
+    std::size_t loadedCursor = 0;
+    t0 = Clock::now();
+    std::size_t frameCount = 0;
+    for (float time = stream.startTime(); streamed && time <= stream.endTime(); time += dt, ++frameCount) {
+        glm::vec3 p, lp;
+        glm::quat q, lq;
+        stream.sample(time, streamCursor, p, q);
+        loaded.sample(time, loadedCursor, lp, lq);
+        streamErr = std::max(streamErr, glm::length(p - lp));
+        peakBytes = std::max(peakBytes, stream.residentBytes());
+    }
+    double streamNs = secondsSince(t0) * 1e9 / double(std::max<std::size_t>(frameCount, 1));
+    streamed = streamed && streamErr == 0.0f;
+    std::cout << "[Bench] Streaming: " << stream.chunkCount() << " chunks, " << stream.chunkLoads()
+              << " loads, peak " << peakBytes << " B decoded vs " << loaded.byteSize()
+              << " B whole clip, " << streamNs << " ns/sample, "
+              << (streamed ? "matches" : "MISMATCH") << "\n";
+    stream.close();
+    std::remove("clip_bench.rclip");
+
+    std::cout << "(checksum " << sink.x + sink.y + sink.z << ")\n";
+    return roundTrip && streamed ? 0 : 1;
+}
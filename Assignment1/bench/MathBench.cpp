@@ -0,0 +1,162 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+// Throughput of the batch maths kernels against the one-at-a-time GLM path.
+// Usage: math_bench [elements] [iterations]
+// Errors are measured on the widest path's output.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+#include <engine/MathUtils.h>
+
+#include "BatchMath.h"
+#include "Transform.h"
+
+using Clock = std::chrono::steady_clock;
+
+static double secondsSince(Clock::time_point t0) {
+    return std::chrono::duration<double>(Clock::now() - t0).count();
+}
+
+// Nanoseconds per element of body() run iterations times over count elements
+template <class Body>
+static double timeNs(std::size_t count, int iterations, Body body) {
+    body(); // warm caches
+    auto t0 = Clock::now();
+    for (int i = 0; i < iterations; ++i) body();
+    return secondsSince(t0) * 1e9 / (double(count) * iterations);
+}
+
+// Distance between two unit quaternions; q and -q are the same rotation
+static float quatError(const glm::quat& a, const glm::quat& b) {
+    glm::vec4 va(a.x, a.y, a.z, a.w), vb(b.x, b.y, b.z, b.w);
+    return std::min(glm::length(va - vb), glm::length(va + vb));
+}
+
+static void report(const char* name, double glmNs, const double batchNs[3],
+    const SimdLevel* levels, int levelCount, float maxError) {
+    std::cout << "[Bench] " << name << ": glm " << glmNs << " ns";
+    for (int l = 0; l < levelCount; ++l)
+        std::cout << ", " << simdLevelName(levels[l]) << " " << batchNs[l] << " ns ("
+                  << glmNs / batchNs[l] << "x)";
+    std::cout << ", max error " << maxError << "\n";
+}
+
+int main(int argc, char** argv) {
+    std::size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+    int iterations    = argc > 2 ? std::atoi(argv[2]) : 200;
+    if (count == 0 || iterations <= 0) return 1;
+
+    // Every level up to the widest this machine runs
+    SimdLevel levels[3];
+    int levelCount = 0;
+    for (SimdLevel l : { SimdLevel::Scalar, SimdLevel::Sse2, SimdLevel::Avx2 })
+        if ((int)l <= (int)detectSimdLevel()) levels[levelCount++] = l;
+
+    std::cout << "[Bench] " << count << " elements x " << iterations << " iterations, best path "
+              << simdLevelName(detectSimdLevel()) << "\n";
+
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::uniform_real_distribution<float> coord(-10.0f, 10.0f);
+    std::uniform_real_distribution<float> angle(-180.0f, 180.0f);
+
+    // Same data in both layouts
+    std::vector<glm::quat> qa(count), qb(count), qOut(count);
+    std::vector<glm::vec3> p[4], eulers(count), vOut(count);
+    std::vector<float> t(count), easeOut(count);
+    QuatArray sa, sb, sq;
+    Vec3Array sp[4], se, sv;
+    sa.resize(count);
+    sb.resize(count);
+    se.resize(count);
+    for (int k = 0; k < 4; ++k) {
+        p[k].resize(count);
+        sp[k].resize(count);
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+        glm::vec3 e(angle(rng), angle(rng), angle(rng));
+        qa[i] = eulerYXZToQuat(e.x, e.y, e.z);
+        qb[i] = eulerYXZToQuat(angle(rng), angle(rng), angle(rng));
+        sa.set(i, qa[i]);
+        sb.set(i, qb[i]);
+        eulers[i] = e;
+        se.set(i, e);
+        for (int k = 0; k < 4; ++k) {
+            p[k][i] = glm::vec3(coord(rng), coord(rng), coord(rng));
+            sp[k].set(i, p[k][i]);
+        }
+        t[i] = unit(rng);
+    }
+
+    double batchNs[3];
+    float maxError;
+
+    // -------------------- Slerp --------------------
+    double glmNs = timeNs(count, iterations, [&] {
+        for (std::size_t i = 0; i < count; ++i) qOut[i] = MathUtils::slerp(qa[i], qb[i], t[i]);
+    });
+    for (int l = 0; l < levelCount; ++l) {
+        setSimdLevel(levels[l]);
+        batchNs[l] = timeNs(count, iterations, [&] { slerpBatch(sa, sb, t.data(), sq); });
+    }
+    maxError = 0.0f;
+    for (std::size_t i = 0; i < count; ++i) maxError = std::max(maxError, quatError(sq.get(i), qOut[i]));
+    report("slerp", glmNs, batchNs, levels, levelCount, maxError);
+
+    // -------------------- Catmull-Rom --------------------
+    glmNs = timeNs(count, iterations, [&] {
+        for (std::size_t i = 0; i < count; ++i)
+            vOut[i] = MathUtils::catmullRom(p[0][i], p[1][i], p[2][i], p[3][i], t[i]);
+    });
+    for (int l = 0; l < levelCount; ++l) {
+        setSimdLevel(levels[l]);
+        batchNs[l] = timeNs(count, iterations,
+            [&] { catmullRomBatch(sp[0], sp[1], sp[2], sp[3], t.data(), sv); });
+    }
+    maxError = 0.0f;
+    for (std::size_t i = 0; i < count; ++i)
+        maxError = std::max(maxError, glm::length(sv.get(i) - vOut[i]));
+    report("catmullRom", glmNs, batchNs, levels, levelCount, maxError);
+
+    // -------------------- Ease --------------------
+    std::vector<float> glmEase(count);
+    glmNs = timeNs(count, iterations, [&] {
+        for (std::size_t i = 0; i < count; ++i) glmEase[i] = MathUtils::easeInOut(t[i]);
+    });
+    for (int l = 0; l < levelCount; ++l) {
+        setSimdLevel(levels[l]);
+        batchNs[l] = timeNs(count, iterations, [&] { easeInOutBatch(t.data(), easeOut.data(), count); });
+    }
+    maxError = 0.0f;
+    for (std::size_t i = 0; i < count; ++i)
+        maxError = std::max(maxError, std::abs(easeOut[i] - glmEase[i]));
+    report("easeInOut", glmNs, batchNs, levels, levelCount, maxError);
+
+    // -------------------- Euler --------------------
+    glmNs = timeNs(count, iterations, [&] {
+        for (std::size_t i = 0; i < count; ++i)
+            qOut[i] = eulerYXZToQuat(eulers[i].x, eulers[i].y, eulers[i].z);
+    });
+    for (int l = 0; l < levelCount; ++l) {
+        setSimdLevel(levels[l]);
+        batchNs[l] = timeNs(count, iterations, [&] { eulerToQuatBatch(se, EulerOrder::YXZ, sq); });
+    }
+    maxError = 0.0f;
+    for (std::size_t i = 0; i < count; ++i) maxError = std::max(maxError, quatError(sq.get(i), qOut[i]));
+    report("eulerYXZ", glmNs, batchNs, levels, levelCount, maxError);
+
+    // Keep the outputs live
+    float sink = 0.0f;
+    for (std::size_t i = 0; i < count; i += 97) sink += qOut[i].w + vOut[i].x + glmEase[i] + sq.w[i] + sv.x[i];
+    std::cout << "(checksum " << sink << ")\n";
+    return 0;
+}
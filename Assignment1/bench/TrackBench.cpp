@@ -0,0 +1,127 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+// Microbenchmark for keyframe sampling.
+// Usage: track_bench [players] [keys] [distinct tracks] [frames]
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+#include <engine/MathUtils.h>
+
+#include "AnimationTrack.h"
+
+using Clock = std::chrono::steady_clock;
+
+static double secondsSince(Clock::time_point t0) {
+    return std::chrono::duration<double>(Clock::now() - t0).count();
+}
+
+// Random walk of keys spaced ~1/30s apart
+static std::vector<Keyframe> makeKeys(std::size_t count, std::mt19937& rng) {
+    std::uniform_real_distribution<float> step(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> spacing(0.02f, 0.05f);
+
+    std::vector<Keyframe> keys(count);
+    glm::vec3 pos(0.0f);
+    float time = -1.0f;
+    for (Keyframe& k : keys) {
+        pos += glm::vec3(step(rng), step(rng), step(rng));
+        time += spacing(rng);
+        k = { pos, glm::quat(1, 0, 0, 0), time };
+    }
+    return keys;
+}
+
+// The original per-frame path: linear scan from the first key
+static glm::vec3 sampleLinear(const std::vector<Keyframe>& keys, float animTime) {
+    int i = 0;
+    while (i + 2 < (int)keys.size() - 1 && animTime > keys[i + 1].time) ++i;
+    i = glm::clamp(i, 1, (int)keys.size() - 3);
+
+    const Keyframe& k1 = keys[i];
+    const Keyframe& k2 = keys[i + 1];
+    float t = (animTime - k1.time) / (k2.time - k1.time);
+    return MathUtils::catmullRom(keys[i - 1].position, k1.position,
+        k2.position, keys[i + 2].position, t);
+}
+
+int main(int argc, char** argv) {
+    std::size_t players  = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 10000;
+    std::size_t keyCount = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 100000;
+    std::size_t distinct = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 8;
+    int frames           = argc > 4 ? std::atoi(argv[4]) : 120;
+    if (keyCount < 4 || distinct == 0 || players == 0) return 1;
+
+    // 10k unique 100k-key tracks would be ~90 GB of segments, so players share
+    // a handful of tracks and differ only in phase and speed
+    std::cout << "[Bench] " << players << " players, " << distinct
+              << " tracks x " << keyCount << " keys, " << frames << " frames\n";
+
+    std::mt19937 rng(7);
+    std::vector<std::vector<Keyframe>> keySets;
+    std::vector<AnimationTrack> tracks;
+    auto t0 = Clock::now();
+    for (std::size_t i = 0; i < distinct; ++i) keySets.push_back(makeKeys(keyCount, rng));
+    for (const auto& keys : keySets) tracks.emplace_back(keys);
+    std::cout << "[Bench] Track build: " << secondsSince(t0) << "s ("
+              << tracks[0].segmentCount() * sizeof(TrackSegment) / (1024.0 * 1024.0)
+              << " MiB/track)\n";
+
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::vector<TrackPlayer> cursors;
+    std::vector<float> speeds;
+    cursors.reserve(players);
+    for (std::size_t i = 0; i < players; ++i) {
+        const AnimationTrack& track = tracks[i % distinct];
+        cursors.emplace_back(&track, unit(rng) * track.duration());
+        speeds.push_back(0.5f + unit(rng));
+    }
+
+    const float dt = 1.0f / 60.0f;
+    glm::vec3 sink(0.0f);
+
+    // Cached cursor playback
+    t0 = Clock::now();
+    for (int f = 0; f < frames; ++f) {
+        for (std::size_t i = 0; i < players; ++i) {
+            cursors[i].advance(dt * speeds[i]);
+            sink += cursors[i].position();
+        }
+    }
+    double cursorNs = secondsSince(t0) * 1e9 / (double(players) * frames);
+
+    // Stateless binary search at the same times
+    t0 = Clock::now();
+    for (int f = 0; f < frames; ++f) {
+        for (std::size_t i = 0; i < players; ++i) {
+            const AnimationTrack& track = *cursors[i].track();
+            float time = cursors[i].time() + dt * speeds[i] * f;
+            time = track.startTime() + std::fmod(time - track.startTime(), track.duration());
+            std::size_t seg = track.findSegment(time);
+            sink += track.samplePosition(seg, track.localTime(seg, time));
+        }
+    }
+    double searchNs = secondsSince(t0) * 1e9 / (double(players) * frames);
+
+    // Linear scan is O(n) per sample, so only run a slice of it
+    std::size_t linearPlayers = std::min<std::size_t>(players, 64);
+    t0 = Clock::now();
+    for (std::size_t i = 0; i < linearPlayers; ++i) {
+        const auto& keys = keySets[i % distinct];
+        sink += sampleLinear(keys, cursors[i].time());
+    }
+    double linearNs = secondsSince(t0) * 1e9 / double(linearPlayers);
+
+    double frameMs = cursorNs * players / 1e6;
+    std::cout << "[Bench] Cursor:        " << cursorNs << " ns/sample (" << frameMs << " ms/frame)\n";
+    std::cout << "[Bench] Binary search: " << searchNs << " ns/sample\n";
+    std::cout << "[Bench] Linear scan:   " << linearNs << " ns/sample\n";
+    std::cout << "(checksum " << sink.x + sink.y + sink.z << ")\n";
+    return 0;
+}
@@ -0,0 +1,116 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#include "AnimationTrack.h"
+
+#include <algorithm>
+#include <cmath>
+#include <engine/MathUtils.h>
+
+// -------------------- AnimationTrack --------------------
+
+AnimationTrack::AnimationTrack(const std::vector<Keyframe>& keys) {
+    // Need a control point on either side of at least one span
+    if (keys.size() < 4) return;
+
+    const std::size_t count = keys.size() - 3;
+    segments.reserve(count);
+    segmentStarts.reserve(count);
+
+    for (std::size_t i = 1; i + 2 < keys.size(); ++i) {
+        const glm::vec3& p0 = keys[i - 1].position;
+        const glm::vec3& p1 = keys[i].position;
+        const glm::vec3& p2 = keys[i + 1].position;
+        const glm::vec3& p3 = keys[i + 2].position;
+
+        // Uniform Catmull-Rom expanded into cubic coefficients
+        TrackSegment seg;
+        seg.a = 0.5f * (-p0 + 3.0f * p1 - 3.0f * p2 + p3);
+        seg.b = 0.5f * (2.0f * p0 - 5.0f * p1 + 4.0f * p2 - p3);
+        seg.c = 0.5f * (p2 - p0);
+        seg.d = p1;
+
+        seg.rot0 = keys[i].rotation;
+        seg.rot1 = keys[i + 1].rotation;
+        seg.startTime = keys[i].time;
+        float span = keys[i + 1].time - keys[i].time;
+        seg.invDuration = span > 0.0f ? 1.0f / span : 0.0f;
+
+        segments.push_back(seg);
+        segmentStarts.push_back(seg.startTime);
+    }
+
+    start = keys[1].time;
+    end = keys[keys.size() - 2].time;
+}
+
+std::size_t AnimationTrack::findSegment(float time) const {
+    // First segment starting after time, then step back one
+    auto it = std::upper_bound(segmentStarts.begin(), segmentStarts.end(), time);
+    if (it == segmentStarts.begin()) return 0;
+    return (std::size_t)(it - segmentStarts.begin()) - 1;
+}
+
+float AnimationTrack::localTime(std::size_t i, float time) const {
+    const TrackSegment& seg = segments[i];
+    return glm::clamp((time - seg.startTime) * seg.invDuration, 0.0f, 1.0f);
+}
+
+glm::vec3 AnimationTrack::samplePosition(std::size_t i, float t) const {
+    const TrackSegment& seg = segments[i];
+    return ((seg.a * t + seg.b) * t + seg.c) * t + seg.d;
+}
+
+glm::vec3 AnimationTrack::sampleTangent(std::size_t i, float t) const {
+    const TrackSegment& seg = segments[i];
+    return (3.0f * seg.a * t + 2.0f * seg.b) * t + seg.c;
+}
+
+glm::quat AnimationTrack::sampleRotation(std::size_t i, float t) const {
+    const TrackSegment& seg = segments[i];
+    return MathUtils::slerp(seg.rot0, seg.rot1, t);
+}
+
+// -------------------- TrackPlayer --------------------
+
+TrackPlayer::TrackPlayer(const AnimationTrack* track, float phase)
+    : clip(track) {
+    if (clip && !clip->empty()) seek(clip->startTime() + phase);
+}
+
+void TrackPlayer::advance(float dt) {
+    if (!clip || clip->empty()) return;
+    seek(animTime + dt);
+}
+
+void TrackPlayer::seek(float time) {
+    if (!clip || clip->empty()) return;
+
+    // Loop back to start when we run past the end (or before the start)
+    float duration = clip->duration();
+    float offset = duration > 0.0f ? std::fmod(time - clip->startTime(), duration) : 0.0f;
+    if (offset < 0.0f) offset += duration;
+    animTime = clip->startTime() + offset;
+
+    locate();
+}
+
+void TrackPlayer::locate() {
+    const std::size_t last = clip->segmentCount() - 1;
+    auto contains = [&](std::size_t i) {
+        const TrackSegment& seg = clip->segment(i);
+        bool afterStart = animTime >= seg.startTime;
+        bool beforeEnd = i == last || animTime < clip->segment(i + 1).startTime;
+        return afterStart && beforeEnd;
+    };
+
+    // Common cases first: still in the same span, or just crossed into the next
+    if (cursor <= last && contains(cursor)) return;
+    if (cursor < last && contains(cursor + 1)) { ++cursor; return; }
+
+    // Looped or jumped: fall back to the binary search
+    cursor = clip->findSegment(animTime);
+}
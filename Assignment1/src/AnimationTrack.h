@@ -0,0 +1,87 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+struct Keyframe {
+    glm::vec3 position;
+    glm::quat rotation;
+    float time; // seconds
+};
+
+// One Catmull-Rom span between two keys, stored in power form so that
+// sampling is a single Horner evaluation: p(t) = ((a*t + b)*t + c)*t + d
+struct TrackSegment {
+    glm::vec3 a, b, c, d;
+    glm::quat rot0, rot1;
+    float startTime;
+    float invDuration;
+};
+
+// Immutable keyframe clip. The first and last keys are Catmull-Rom control
+// points only, so playback runs from keys[1].time to keys[n-2].time.
+class AnimationTrack {
+public:
+    AnimationTrack() = default;
+    explicit AnimationTrack(const std::vector<Keyframe>& keys);
+
+    bool empty() const { return segments.empty(); }
+    std::size_t segmentCount() const { return segments.size(); }
+    const TrackSegment& segment(std::size_t i) const { return segments[i]; }
+
+    float startTime() const { return start; }
+    float endTime() const { return end; }
+    float duration() const { return end - start; }
+
+    // Binary search for the segment containing time (clamped to the clip)
+    std::size_t findSegment(float time) const;
+    // Normalized [0, 1] parameter of time inside segment i
+    float localTime(std::size_t i, float time) const;
+
+    glm::vec3 samplePosition(std::size_t i, float t) const;
+    // Analytic derivative dp/dt of segment i (not normalized)
+    glm::vec3 sampleTangent(std::size_t i, float t) const;
+    glm::quat sampleRotation(std::size_t i, float t) const;
+
+private:
+    std::vector<TrackSegment> segments;
+    std::vector<float> segmentStarts; // packed separately for the search
+    float start = 0.0f;
+    float end = 0.0f;
+};
+
+// Per-instance playback state over a shared track. The cursor is reused
+// between frames, so normal forward playback never searches at all.
+class TrackPlayer {
+public:
+    TrackPlayer() = default;
+    explicit TrackPlayer(const AnimationTrack* track, float phase = 0.0f);
+
+    // Advance (and loop) playback time, then update the cached segment
+    void advance(float dt);
+    // Jump to an absolute clip time
+    void seek(float time);
+
+    const AnimationTrack* track() const { return clip; }
+    float time() const { return animTime; }
+    std::size_t segment() const { return cursor; }
+    float localTime() const { return clip->localTime(cursor, animTime); }
+
+    glm::vec3 position() const { return clip->samplePosition(cursor, localTime()); }
+    glm::quat rotation() const { return clip->sampleRotation(cursor, localTime()); }
+
+private:
+    void locate();
+
+    const AnimationTrack* clip = nullptr;
+    float animTime = 0.0f;
+    std::size_t cursor = 0;
+};
@@ -0,0 +1,80 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#include "ArcLengthTable.h"
+
+#include <cmath>
+#include <glm/gtc/matrix_transform.hpp>
+
+glm::quat lookRotation(const glm::vec3& forward, const glm::vec3& up) {
+    // Pick another up axis if we are flying (almost) straight up or down
+    glm::vec3 safeUp = up;
+    if (glm::length(glm::cross(forward, up)) < 1e-4f) safeUp = glm::vec3(0.0f, 0.0f, 1.0f);
+
+    glm::mat4 look = glm::lookAt(glm::vec3(0.0f), -forward, safeUp);
+    return glm::normalize(glm::quat_cast(glm::inverse(look)));
+}
+
+ArcLengthTable::ArcLengthTable(const AnimationTrack& track,
+    int samplesPerSegment, int entriesPerSegment)
+    : source(&track) {
+    if (track.empty() || samplesPerSegment < 1 || entriesPerSegment < 1) return;
+
+    // Dense chord-length pass: cumulative distance at each global parameter
+    const int segCount = (int)track.segmentCount();
+    const int sampleCount = segCount * samplesPerSegment;
+    std::vector<float> cumulative(sampleCount + 1, 0.0f);
+
+    glm::vec3 prev = track.samplePosition(0, 0.0f);
+    for (int k = 1; k <= sampleCount; ++k) {
+        int seg = glm::min((k - 1) / samplesPerSegment, segCount - 1);
+        float t = float(k - seg * samplesPerSegment) / float(samplesPerSegment);
+        glm::vec3 pos = track.samplePosition(seg, t);
+        cumulative[k] = cumulative[k - 1] + glm::length(pos - prev);
+        prev = pos;
+    }
+    totalLength = cumulative.back();
+    if (totalLength <= 0.0f) return;
+
+    // Invert it onto an evenly spaced distance grid
+    const int entries = segCount * entriesPerSegment;
+    params.resize(entries + 1);
+    entriesPerUnit = float(entries) / totalLength;
+
+    int k = 0;
+    for (int j = 0; j <= entries; ++j) {
+        float s = float(j) / entriesPerUnit;
+        while (k + 1 < sampleCount && cumulative[k + 1] < s) ++k;
+
+        float span = cumulative[k + 1] - cumulative[k];
+        float frac = span > 0.0f ? glm::clamp((s - cumulative[k]) / span, 0.0f, 1.0f) : 0.0f;
+        params[j] = (float(k) + frac) / float(samplesPerSegment);
+    }
+}
+
+PathSample ArcLengthTable::sample(float distance) const {
+    PathSample out{ glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::quat(1, 0, 0, 0) };
+    if (empty()) return out;
+
+    // Loop back to start when we run past the end
+    float s = std::fmod(distance, totalLength);
+    if (s < 0.0f) s += totalLength;
+
+    // O(1): direct index into the evenly spaced table
+    float f = s * entriesPerUnit;
+    int j = glm::min((int)f, (int)params.size() - 2);
+    float u = glm::mix(params[j], params[j + 1], f - float(j));
+
+    int last = (int)source->segmentCount() - 1;
+    int seg = glm::min((int)u, last);
+    float t = glm::clamp(u - float(seg), 0.0f, 1.0f);
+
+    out.position = source->samplePosition(seg, t);
+    glm::vec3 tangent = source->sampleTangent(seg, t);
+    if (glm::length(tangent) > 1e-6f) out.forward = glm::normalize(tangent);
+    out.rotation = lookRotation(out.forward);
+    return out;
+}
@@ -0,0 +1,47 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#pragma once
+
+#include <vector>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include "AnimationTrack.h"
+
+struct PathSample {
+    glm::vec3 position;
+    glm::vec3 forward; // unit tangent
+    glm::quat rotation; // look rotation along forward
+};
+
+// Rotation whose +Z axis faces forward, with +Y kept as close to up as possible
+glm::quat lookRotation(const glm::vec3& forward,
+    const glm::vec3& up = glm::vec3(0.0f, 1.0f, 0.0f));
+
+// Reparameterises a track by distance travelled. Built once per path: the
+// spline is densely sampled, then resampled into a table evenly spaced in
+// arc length, so lookups are a single lerp regardless of knot spacing.
+class ArcLengthTable {
+public:
+    ArcLengthTable() = default;
+    explicit ArcLengthTable(const AnimationTrack& track,
+        int samplesPerSegment = 128, int entriesPerSegment = 128);
+
+    bool empty() const { return params.size() < 2; }
+    float length() const { return totalLength; }
+    const AnimationTrack* track() const { return source; }
+
+    // Wraps distance into [0, length) and evaluates the spline there
+    PathSample sample(float distance) const;
+
+private:
+    const AnimationTrack* source = nullptr;
+    // Global spline parameter (segment index + local t) at even distances
+    std::vector<float> params;
+    float totalLength = 0.0f;
+    float entriesPerUnit = 0.0f;
+};
@@ -0,0 +1,79 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#include "AssetManager.h"
+
+#include <iostream>
+
+AssetManager::AssetManager(ThreadPool& pool) : workers(pool) {}
+
+AssetManager::~AssetManager() {
+    // Worker steps keep their job alive themselves, not what they capture
+    workers.wait();
+}
+
+AssetHandle AssetManager::load(const std::string& name, std::function<bool()> work,
+    std::function<bool()> create) {
+    auto job = std::make_shared<Job>();
+    job->status = std::make_shared<AssetStatus>(name);
+    job->create = std::move(create);
+    job->queued = Clock::now();
+    if (work) {
+        job->work = std::move(work);
+        workers.submit([job] {
+            if (!job->work()) job->loadFailed = true;
+            job->work = nullptr;
+            job->loaded = true;
+        });
+    } else {
+        job->loaded = true;
+    }
+    jobs.push_back(job);
+    return job->status;
+}
+
+void AssetManager::update(double budgetMs) {
+    const Clock::time_point start = Clock::now();
+    bool first = true;
+    std::size_t i = 0;
+    while (i < jobs.size()) {
+        Job& job = *jobs[i];
+        if (!job.loaded) { ++i; continue; }
+        if (job.loadFailed) {
+            finish(job, AssetState::Failed);
+            jobs.erase(jobs.begin() + i);
+            continue;
+        }
+
+        // An unfinished GL step holds back everything queued after it
+        if (!first && std::chrono::duration<double, std::milli>(Clock::now() - start).count() >= budgetMs)
+            return;
+        first = false;
+        job.status->current = AssetState::Creating;
+        if (job.create && !job.create()) return;
+        finish(job, AssetState::Ready);
+        jobs.erase(jobs.begin() + i);
+    }
+}
+
+void AssetManager::finish(Job& job, AssetState state) {
+    AssetStatus& status = *job.status;
+    status.elapsed = std::chrono::duration<float>(Clock::now() - job.queued).count();
+    status.current = state;
+    if (state == AssetState::Failed) {
+        std::cerr << "[Asset] Failed to load " << status.name() << std::endl;
+        return;
+    }
+    times.push_back({ status.name(), status.elapsed });
+    std::cout << "[Asset] " << status.name() << " ready after " << status.elapsed << "s\n";
+}
+
+void ModelAsset::load(AssetManager& assets, const std::string& path) {
+    status = assets.load(path, nullptr, [this, path] {
+        model = std::make_unique<Model>(path.c_str());
+        return true;
+    });
+}
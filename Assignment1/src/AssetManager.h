@@ -0,0 +1,112 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include <engine/Model.h>
+
+#include "ThreadPool.h"
+
+// Where an asset is in AssetManager's pipeline
+enum class AssetState { Loading, Creating, Ready, Failed };
+
+// Loading state of one asset, shared between the manager and whoever draws it
+class AssetStatus {
+public:
+    explicit AssetStatus(std::string name) : assetName(std::move(name)) {}
+
+    AssetState state() const { return current; }
+    bool ready() const { return current == AssetState::Ready; }
+    bool failed() const { return current == AssetState::Failed; }
+    const std::string& name() const { return assetName; }
+    // Seconds from load() to ready (or failed); 0 while in flight
+    float seconds() const { return elapsed; }
+
+private:
+    friend class AssetManager;
+
+    std::string assetName;
+    std::atomic<AssetState> current{ AssetState::Loading };
+    float elapsed = 0.0f;
+};
+
+using AssetHandle = std::shared_ptr<const AssetStatus>;
+
+// Loads assets without holding up the render loop:
+//   worker: file I/O, decoding, parsing (no GL)
+//   GL thread: object creation in update(), under a per-frame time budget
+// The GL step is called again every frame until it reports done, so a big
+// upload can be cut into pieces that each fit the budget. One asset creates
+// at a time, the oldest whose worker step is done first; the caller draws
+// each one once ready().
+class AssetManager {
+public:
+    explicit AssetManager(ThreadPool& pool);
+    // Waits for worker steps still running. Whatever they capture by
+    // reference must be declared before the manager so it outlives this.
+    ~AssetManager();
+
+    AssetManager(const AssetManager&) = delete;
+    AssetManager& operator=(const AssetManager&) = delete;
+
+    // Queues an asset. work runs on a worker and returns false on failure;
+    // create runs on the GL thread and returns true once done. Either may
+    // be empty.
+    AssetHandle load(const std::string& name, std::function<bool()> work,
+        std::function<bool()> create);
+
+    // Runs GL steps of loaded assets, oldest first, until budgetMs is
+    // spent. The first step always runs, so an asset bigger than the budget
+    // still finishes. Call once per frame on the GL thread.
+    void update(double budgetMs = 2.0);
+
+    bool idle() const { return jobs.empty(); }
+    int pending() const { return (int)jobs.size(); }
+    // Ready time of every asset, in the order they finished
+    const std::vector<std::pair<std::string, float>>& loadTimes() const { return times; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Job {
+        std::shared_ptr<AssetStatus> status;
+        std::function<bool()> work;
+        std::function<bool()> create;
+        Clock::time_point queued;
+        std::atomic<bool> loaded{ false };
+        std::atomic<bool> loadFailed{ false };
+    };
+
+    void finish(Job& job, AssetState state);
+
+    ThreadPool& workers;
+    std::vector<std::shared_ptr<Job>> jobs;
+    std::vector<std::pair<std::string, float>> times;
+};
+
+// The engine Model behind a ready flag. Its constructor reads the file and
+// creates the GL objects in one go, so the whole construction is the
+// asset's GL step and cannot be split across frames; get() is null until
+// it has run.
+class ModelAsset {
+public:
+    void load(AssetManager& assets, const std::string& path);
+
+    bool ready() const { return status && status->ready(); }
+    const AssetHandle& handle() const { return status; }
+    Model* get() { return model.get(); }
+
+private:
+    std::unique_ptr<Model> model;
+    AssetHandle status;
+};
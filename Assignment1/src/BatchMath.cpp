@@ -0,0 +1,121 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#include "BatchMath.h"
+
+#include "BatchMathKernels.h"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+// BatchMathAvx2.cpp; null when the build has no AVX2 path
+const BatchKernels* avx2BatchKernels();
+
+namespace {
+
+bool cpuHasAvx2() {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    // AVX2 and FMA in CPUID, plus the OS saving YMM state (XCR0 bits 1-2)
+    int info[4];
+    __cpuid(info, 1);
+    bool fma = (info[2] & (1 << 12)) != 0;
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    if (!fma || !osxsave || (_xgetbv(0) & 6) != 6) return false;
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#else
+    return false;
+#endif
+}
+
+constexpr BatchKernels ScalarKernels = makeKernels<F1>();
+#ifdef RTA_SSE
+constexpr BatchKernels Sse2Kernels = makeKernels<F4>();
+#endif
+
+// Detected on first use, so it is safe from other static initialisers
+SimdLevel& currentLevel() {
+    static SimdLevel level = detectSimdLevel();
+    return level;
+}
+
+const BatchKernels& kernels() {
+    switch (currentLevel()) {
+    case SimdLevel::Avx2: return *avx2BatchKernels();
+#ifdef RTA_SSE
+    case SimdLevel::Sse2: return Sse2Kernels;
+#endif
+    default: return ScalarKernels;
+    }
+}
+
+} // namespace
+
+// -------------------- Dispatch --------------------
+
+SimdLevel detectSimdLevel() {
+    if (avx2BatchKernels() && cpuHasAvx2()) return SimdLevel::Avx2;
+#ifdef RTA_SSE
+    return SimdLevel::Sse2;
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+SimdLevel simdLevel() {
+    return currentLevel();
+}
+
+void setSimdLevel(SimdLevel level) {
+    SimdLevel best = detectSimdLevel();
+    currentLevel() = (int)level < (int)best ? level : best;
+}
+
+const char* simdLevelName(SimdLevel level) {
+    switch (level) {
+    case SimdLevel::Avx2: return "avx2";
+    case SimdLevel::Sse2: return "sse2";
+    default: return "scalar";
+    }
+}
+
+// -------------------- Batches --------------------
+
+void slerpBatch(const QuatArray& a, const QuatArray& b, const float* t, QuatArray& out) {
+    out.resize(a.size());
+    const float* const in0[4] = { a.x.data(), a.y.data(), a.z.data(), a.w.data() };
+    const float* const in1[4] = { b.x.data(), b.y.data(), b.z.data(), b.w.data() };
+    float* const dst[4] = { out.x.data(), out.y.data(), out.z.data(), out.w.data() };
+    kernels().slerp(in0, in1, t, dst, a.size());
+}
+
+void catmullRomBatch(const Vec3Array& p0, const Vec3Array& p1, const Vec3Array& p2,
+    const Vec3Array& p3, const float* t, Vec3Array& out) {
+    out.resize(p0.size());
+    const float* const in[4][3] = {
+        { p0.x.data(), p0.y.data(), p0.z.data() },
+        { p1.x.data(), p1.y.data(), p1.z.data() },
+        { p2.x.data(), p2.y.data(), p2.z.data() },
+        { p3.x.data(), p3.y.data(), p3.z.data() }
+    };
+    float* const dst[3] = { out.x.data(), out.y.data(), out.z.data() };
+    kernels().catmullRom(in, t, dst, p0.size());
+}
+
+void easeInOutBatch(const float* t, float* out, std::size_t count) {
+    kernels().easeInOut(t, out, count);
+}
+
+void eulerToQuatBatch(const Vec3Array& eulerDeg, EulerOrder order, QuatArray& out) {
+    out.resize(eulerDeg.size());
+    const float* const in[3] = { eulerDeg.x.data(), eulerDeg.y.data(), eulerDeg.z.data() };
+    float* const dst[4] = { out.x.data(), out.y.data(), out.z.data(), out.w.data() };
+    kernels().eulerToQuat(in, (int)order, dst, eulerDeg.size());
+}
@@ -0,0 +1,67 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+// Batch versions of the per-object animation maths (MathUtils slerp,
+// catmullRom, easeInOut and Euler -> quaternion) over structure-of-arrays
+// data, so each instruction works on 4 (SSE2) or 8 (AVX2) elements.
+// The widest path the CPU supports is picked at runtime; every path runs
+// the same formulas, so results only differ by rounding.
+
+// One array per component
+struct QuatArray {
+    std::vector<float> x, y, z, w;
+
+    void resize(std::size_t n) { x.resize(n); y.resize(n); z.resize(n); w.resize(n); }
+    std::size_t size() const { return w.size(); }
+    void set(std::size_t i, const glm::quat& q) { x[i] = q.x; y[i] = q.y; z[i] = q.z; w[i] = q.w; }
+    glm::quat get(std::size_t i) const { return glm::quat(w[i], x[i], y[i], z[i]); }
+};
+
+struct Vec3Array {
+    std::vector<float> x, y, z;
+
+    void resize(std::size_t n) { x.resize(n); y.resize(n); z.resize(n); }
+    std::size_t size() const { return x.size(); }
+    void set(std::size_t i, const glm::vec3& v) { x[i] = v.x; y[i] = v.y; z[i] = v.z; }
+    glm::vec3 get(std::size_t i) const { return glm::vec3(x[i], y[i], z[i]); }
+};
+
+enum class SimdLevel { Scalar, Sse2, Avx2 };
+
+// Widest level this CPU (and build) can run
+SimdLevel detectSimdLevel();
+// Level the batch functions currently use; starts at detectSimdLevel()
+SimdLevel simdLevel();
+// Forces a narrower path (benchmarks); clamped to what the CPU supports
+void setSimdLevel(SimdLevel level);
+const char* simdLevelName(SimdLevel level);
+
+// Composition order, left to right: YXZ is qy * qx * qz (eulerYXZToQuat)
+enum class EulerOrder { XYZ, YXZ, ZYX };
+
+// All inputs of one call must have the same length; out is resized to it.
+
+// out[i] = shortest-arc slerp(a[i], b[i], t[i]). Uses Eberly's polynomial
+// form, so there is no trig, division or branch; within 4e-5 of exact,
+// worst for rotations near 180 degrees apart.
+void slerpBatch(const QuatArray& a, const QuatArray& b, const float* t, QuatArray& out);
+
+// Uniform Catmull-Rom between p1 and p2, as MathUtils::catmullRom
+void catmullRomBatch(const Vec3Array& p0, const Vec3Array& p1, const Vec3Array& p2,
+    const Vec3Array& p3, const float* t, Vec3Array& out);
+
+// Smoothstep 3t^2 - 2t^3, as MathUtils::easeInOut
+void easeInOutBatch(const float* t, float* out, std::size_t count);
+
+// Degrees (x pitch, y yaw, z roll) to unit quaternions
+void eulerToQuatBatch(const Vec3Array& eulerDeg, EulerOrder order, QuatArray& out);
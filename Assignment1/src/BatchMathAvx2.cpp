@@ -0,0 +1,19 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+// Built with AVX2 code generation (see CMakeLists.txt); only reached after
+// BatchMath.cpp has checked the CPU supports it.
+
+#include "BatchMathKernels.h"
+
+const BatchKernels* avx2BatchKernels() {
+#ifdef __AVX2__
+    static constexpr BatchKernels kernels = makeKernels<F8>();
+    return &kernels;
+#else
+    return nullptr;
+#endif
+}
@@ -0,0 +1,259 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#pragma once
+
+// Kernel bodies shared by BatchMath.cpp (scalar, SSE2) and
+// BatchMathAvx2.cpp (AVX2). Each kernel is written once against a small
+// vector type (F1, F4 or F8) and instantiated per instruction set.
+//
+// Everything here has internal linkage on purpose: the AVX2 file is
+// compiled with -mavx2, and its copies of shared helpers must never be
+// merged with the baseline ones by the linker. For the same reason this
+// header includes no glm and calls nothing from the C library: even the
+// scalar tails are plain inline arithmetic.
+
+#include <cstddef>
+
+#include "SimdConfig.h"
+
+#ifdef RTA_SSE
+#include <emmintrin.h>
+#endif
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+// Raw component pointers, one table per instruction set
+struct BatchKernels {
+    void (*slerp)(const float* const a[4], const float* const b[4], const float* t,
+        float* const out[4], std::size_t count);
+    void (*catmullRom)(const float* const p[4][3], const float* t, float* const out[3],
+        std::size_t count);
+    void (*easeInOut)(const float* t, float* out, std::size_t count);
+    void (*eulerToQuat)(const float* const euler[3], int order, float* const out[4],
+        std::size_t count);
+};
+
+namespace {
+
+// -------------------- Vector types --------------------
+
+struct M1 { bool v; };
+struct F1 {
+    static constexpr std::size_t Width = 1;
+    float v;
+    F1() = default;
+    F1(float s) : v(s) {}
+    static F1 load(const float* p) { return F1(*p); }
+    void store(float* p) const { *p = v; }
+};
+inline F1 operator+(F1 a, F1 b) { return a.v + b.v; }
+inline F1 operator-(F1 a, F1 b) { return a.v - b.v; }
+inline F1 operator*(F1 a, F1 b) { return a.v * b.v; }
+inline F1 operator-(F1 a) { return -a.v; }
+inline M1 operator<(F1 a, F1 b) { return { a.v < b.v }; }
+inline M1 operator>(F1 a, F1 b) { return { a.v > b.v }; }
+inline M1 operator&(M1 a, M1 b) { return { a.v && b.v }; }
+inline F1 select(M1 m, F1 a, F1 b) { return m.v ? a : b; }
+inline F1 vfloor(F1 a) {
+    // No std::floor: a library call here would be an out-of-line, VEX-encoded
+    // copy in the AVX2 file. Truncate and step down like vfloor(F4); beyond
+    // 2^23 (and for NaN) the value is already whole.
+    if (!(a.v < 8388608.0f && a.v > -8388608.0f)) return a;
+    float t = (float)(int)a.v;
+    return t > a.v ? t - 1.0f : t;
+}
+
+#ifdef RTA_SSE
+struct M4 { __m128 v; };
+struct F4 {
+    static constexpr std::size_t Width = 4;
+    __m128 v;
+    F4() = default;
+    F4(__m128 x) : v(x) {}
+    F4(float s) : v(_mm_set1_ps(s)) {}
+    static F4 load(const float* p) { return _mm_loadu_ps(p); }
+    void store(float* p) const { _mm_storeu_ps(p, v); }
+};
+inline F4 operator+(F4 a, F4 b) { return _mm_add_ps(a.v, b.v); }
+inline F4 operator-(F4 a, F4 b) { return _mm_sub_ps(a.v, b.v); }
+inline F4 operator*(F4 a, F4 b) { return _mm_mul_ps(a.v, b.v); }
+inline F4 operator-(F4 a) { return _mm_xor_ps(a.v, _mm_set1_ps(-0.0f)); }
+inline M4 operator<(F4 a, F4 b) { return { _mm_cmplt_ps(a.v, b.v) }; }
+inline M4 operator>(F4 a, F4 b) { return { _mm_cmpgt_ps(a.v, b.v) }; }
+inline M4 operator&(M4 a, M4 b) { return { _mm_and_ps(a.v, b.v) }; }
+inline F4 select(M4 m, F4 a, F4 b) {
+    return _mm_or_ps(_mm_and_ps(m.v, a.v), _mm_andnot_ps(m.v, b.v));
+}
+inline F4 vfloor(F4 a) {
+    // SSE2 has no floor: truncate, then step down where that rounded up
+    __m128 t = _mm_cvtepi32_ps(_mm_cvttps_epi32(a.v));
+    return _mm_sub_ps(t, _mm_and_ps(_mm_cmpgt_ps(t, a.v), _mm_set1_ps(1.0f)));
+}
+#endif
+
+#ifdef __AVX2__
+struct M8 { __m256 v; };
+struct F8 {
+    static constexpr std::size_t Width = 8;
+    __m256 v;
+    F8() = default;
+    F8(__m256 x) : v(x) {}
+    F8(float s) : v(_mm256_set1_ps(s)) {}
+    static F8 load(const float* p) { return _mm256_loadu_ps(p); }
+    void store(float* p) const { _mm256_storeu_ps(p, v); }
+};
+inline F8 operator+(F8 a, F8 b) { return _mm256_add_ps(a.v, b.v); }
+inline F8 operator-(F8 a, F8 b) { return _mm256_sub_ps(a.v, b.v); }
+inline F8 operator*(F8 a, F8 b) { return _mm256_mul_ps(a.v, b.v); }
+inline F8 operator-(F8 a) { return _mm256_xor_ps(a.v, _mm256_set1_ps(-0.0f)); }
+inline M8 operator<(F8 a, F8 b) { return { _mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ) }; }
+inline M8 operator>(F8 a, F8 b) { return { _mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ) }; }
+inline M8 operator&(M8 a, M8 b) { return { _mm256_and_ps(a.v, b.v) }; }
+inline F8 select(M8 m, F8 a, F8 b) { return _mm256_blendv_ps(b.v, a.v, m.v); }
+inline F8 vfloor(F8 a) { return _mm256_floor_ps(a.v); }
+#endif
+
+// Runs op over [0, count) in steps of F::Width, finishing the tail with F1
+template <class F, class Op>
+void forEachLane(std::size_t count, Op op) {
+    std::size_t i = 0;
+    for (; i + F::Width <= count; i += F::Width) op(F(), i);
+    for (; i < count; ++i) op(F1(), i);
+}
+
+// -------------------- Helpers --------------------
+
+// Eberly, "A Fast and Accurate Algorithm for Computing SLERP" (2011):
+// u[k] = 1 / ((k+1)(2k+3)), v[k] = (k+1) / (2k+3), last term scaled by
+// 1 + mu to absorb the truncation error
+const float SlerpMu = 1.90110745351730037f;
+const float SlerpU[8] = { 1.0f / 3, 1.0f / 10, 1.0f / 21, 1.0f / 36, 1.0f / 55, 1.0f / 78,
+                          1.0f / 105, SlerpMu / 136 };
+const float SlerpV[8] = { 1.0f / 3, 2.0f / 5, 3.0f / 7, 4.0f / 9, 5.0f / 11, 6.0f / 13,
+                          7.0f / 15, SlerpMu * 8 / 17 };
+
+// sin and cos together: reduce to [-pi/4, pi/4] by quadrant (Cody-Waite),
+// then the Cephes minimax polynomials
+template <class V>
+void sinCos(V x, V& s, V& c) {
+    V q = vfloor(x * V(0.636619772f) + V(0.5f));
+    V r = (x - q * V(1.57079637f)) - q * V(-4.37113900e-8f);
+    V r2 = r * r;
+
+    V sr = r + r * r2 * (V(-1.66666546e-1f) + r2 * (V(8.33216087e-3f) + r2 * V(-1.95152959e-4f)));
+    V cr = V(1.0f) - V(0.5f) * r2 +
+           r2 * r2 * (V(4.16666457e-2f) + r2 * (V(-1.38873163e-3f) + r2 * V(2.44331571e-5f)));
+
+    V quadrant = q - V(4.0f) * vfloor(q * V(0.25f));
+    auto odd = quadrant - V(2.0f) * vfloor(quadrant * V(0.5f)) > V(0.5f);
+    s = select(odd, cr, sr);
+    c = select(odd, sr, cr);
+    s = select(quadrant > V(1.5f), -s, s);
+    c = select((quadrant > V(0.5f)) & (quadrant < V(2.5f)), -c, c);
+}
+
+// Quaternion product on (x, y, z, w) lanes
+template <class V>
+void quatMul(const V a[4], const V b[4], V out[4]) {
+    out[0] = a[3] * b[0] + a[0] * b[3] + a[1] * b[2] - a[2] * b[1];
+    out[1] = a[3] * b[1] - a[0] * b[2] + a[1] * b[3] + a[2] * b[0];
+    out[2] = a[3] * b[2] + a[0] * b[1] - a[1] * b[0] + a[2] * b[3];
+    out[3] = a[3] * b[3] - a[0] * b[0] - a[1] * b[1] - a[2] * b[2];
+}
+
+// -------------------- Kernels --------------------
+
+template <class F>
+void slerpKernel(const float* const a[4], const float* const b[4], const float* t,
+    float* const out[4], std::size_t count) {
+    forEachLane<F>(count, [&](auto lane, std::size_t i) {
+        using V = decltype(lane);
+        V qa[4], qb[4];
+        for (int k = 0; k < 4; ++k) {
+            qa[k] = V::load(a[k] + i);
+            qb[k] = V::load(b[k] + i);
+        }
+        V tt = V::load(t + i);
+
+        // Flip b onto a's hemisphere for the shorter arc
+        V cosTheta = qa[0] * qb[0] + qa[1] * qb[1] + qa[2] * qb[2] + qa[3] * qb[3];
+        V sign = select(cosTheta < V(0.0f), V(-1.0f), V(1.0f));
+        V xm1 = cosTheta * sign - V(1.0f);
+        V d = V(1.0f) - tt;
+        V sqrT = tt * tt, sqrD = d * d;
+
+        V cT(1.0f), cD(1.0f);
+        for (int k = 7; k >= 0; --k) {
+            cT = V(1.0f) + (V(SlerpU[k]) * sqrT - V(SlerpV[k])) * xm1 * cT;
+            cD = V(1.0f) + (V(SlerpU[k]) * sqrD - V(SlerpV[k])) * xm1 * cD;
+        }
+        cT = cT * tt * sign;
+        cD = cD * d;
+        for (int k = 0; k < 4; ++k) (qa[k] * cD + qb[k] * cT).store(out[k] + i);
+    });
+}
+
+template <class F>
+void catmullRomKernel(const float* const p[4][3], const float* t, float* const out[3],
+    std::size_t count) {
+    forEachLane<F>(count, [&](auto lane, std::size_t i) {
+        using V = decltype(lane);
+        V tt = V::load(t + i);
+        for (int c = 0; c < 3; ++c) {
+            V p0 = V::load(p[0][c] + i), p1 = V::load(p[1][c] + i);
+            V p2 = V::load(p[2][c] + i), p3 = V::load(p[3][c] + i);
+            // Power form, as TrackSegment
+            V ca = V(0.5f) * (V(3.0f) * (p1 - p2) + p3 - p0);
+            V cb = V(0.5f) * (V(2.0f) * p0 - V(5.0f) * p1 + V(4.0f) * p2 - p3);
+            V cc = V(0.5f) * (p2 - p0);
+            (((ca * tt + cb) * tt + cc) * tt + p1).store(out[c] + i);
+        }
+    });
+}
+
+template <class F>
+void easeInOutKernel(const float* t, float* out, std::size_t count) {
+    forEachLane<F>(count, [&](auto lane, std::size_t i) {
+        using V = decltype(lane);
+        V tt = V::load(t + i);
+        (tt * tt * (V(3.0f) - V(2.0f) * tt)).store(out + i);
+    });
+}
+
+template <class F>
+void eulerToQuatKernel(const float* const euler[3], int order, float* const out[4],
+    std::size_t count) {
+    // Axis sequence per EulerOrder (XYZ, YXZ, ZYX)
+    static const int Axes[3][3] = { { 0, 1, 2 }, { 1, 0, 2 }, { 2, 1, 0 } };
+    const int* axes = Axes[order];
+
+    forEachLane<F>(count, [&](auto lane, std::size_t i) {
+        using V = decltype(lane);
+        // One rotation per axis from the half angle (degrees -> radians / 2)
+        V axis[3][4];
+        for (int k = 0; k < 3; ++k) {
+            V s, c;
+            sinCos(V::load(euler[k] + i) * V(0.00872664626f), s, c);
+            for (int j = 0; j < 3; ++j) axis[k][j] = V(0.0f);
+            axis[k][k] = s;
+            axis[k][3] = c;
+        }
+
+        V partial[4], q[4];
+        quatMul(axis[axes[0]], axis[axes[1]], partial);
+        quatMul(partial, axis[axes[2]], q);
+        for (int k = 0; k < 4; ++k) q[k].store(out[k] + i);
+    });
+}
+
+template <class F>
+constexpr BatchKernels makeKernels() {
+    return { slerpKernel<F>, catmullRomKernel<F>, easeInOutKernel<F>, eulerToQuatKernel<F> };
+}
+
+} // namespace
@@ -0,0 +1,169 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#include "BenchMode.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <GLFW/glfw3.h>
+
+namespace {
+
+const int PhaseCount = 3;
+
+float percentile(const std::vector<float>& sorted, float p) {
+    if (sorted.empty()) return 0.0f;
+    size_t k = std::min(sorted.size() - 1, (size_t)(p * (float)(sorted.size() - 1) + 0.5f));
+    return sorted[k];
+}
+
+// Load step names are ours, but keep the output valid JSON regardless
+std::string jsonEscape(const std::string& s) {
+    std::string out;
+    for (char c : s) {
+        if (c == '"' || c == '\\') out += '\\';
+        if ((unsigned char)c < 0x20) continue;
+        out += c;
+    }
+    return out;
+}
+
+} // namespace
+
+// -------------------- Options --------------------
+
+BenchOptions parseBenchOptions(int argc, char** argv) {
+    BenchOptions options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (arg == "--bench") options.enabled = true;
+        else if (arg == "--bench-frames" && hasValue) options.frames = std::max(PhaseCount, std::atoi(argv[++i]));
+        else if (arg == "--bench-warmup" && hasValue) options.warmupFrames = std::max(0, std::atoi(argv[++i]));
+        else if (arg == "--bench-dt" && hasValue) options.dt = (float)std::atof(argv[++i]);
+        else if (arg == "--bench-out" && hasValue) options.outPath = argv[++i];
+    }
+    if (!(options.dt > 0.0f)) options.dt = 1.0f / 60.0f;
+    return options;
+}
+
+void prepareHeadlessWindow() {
+#ifdef GLFW_PLATFORM_NULL
+    // No X11/Wayland to talk to: render through EGL on the null platform
+    if (!std::getenv("DISPLAY") && !std::getenv("WAYLAND_DISPLAY")) {
+        glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+        std::cout << "[Bench] No display, using the GLFW null platform\n";
+    }
+#endif
+    // initWindow's own glfwInit is a no-op once this has run, and the
+    // hints below stay set for its glfwCreateWindow
+    glfwInit();
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+#ifdef GLFW_PLATFORM_NULL
+    if (glfwGetPlatform() == GLFW_PLATFORM_NULL)
+        glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_EGL_CONTEXT_API);
+#endif
+}
+
+// -------------------- Scenario --------------------
+
+BenchScenario::BenchScenario(const BenchOptions& options)
+    : options(options), warmup(options.warmupFrames) {
+    frameMs.reserve(options.frames);
+}
+
+void BenchScenario::advance(bool ready, float ms) {
+    if (!started) {
+        started = ready;
+        return;
+    }
+    if (warmup > 0) {
+        warmup--;
+        return;
+    }
+    if (!done()) frameMs.push_back(ms);
+}
+
+BenchPhase BenchScenario::phase() const {
+    int perPhase = options.frames / PhaseCount;
+    int index = std::min((int)frameMs.size() / perPhase, PhaseCount - 1);
+    return (BenchPhase)index;
+}
+
+int BenchScenario::phaseFrame() const {
+    int perPhase = options.frames / PhaseCount;
+    return (int)frameMs.size() - (int)phase() * perPhase;
+}
+
+const char* benchPhaseName(BenchPhase phase) {
+    switch (phase) {
+    case BenchPhase::Keyframes: return "keyframes";
+    case BenchPhase::Cinema: return "cinema";
+    case BenchPhase::Quaternion: return "quaternion";
+    }
+    return "unknown";
+}
+
+// -------------------- Report --------------------
+
+bool writeBenchJson(const std::string& path, const BenchOptions& options,
+    const std::vector<float>& frameMs,
+    const std::vector<std::pair<std::string, float>>& loadTimings,
+    const std::string& renderer) {
+    std::vector<float> sorted = frameMs;
+    std::sort(sorted.begin(), sorted.end());
+
+    double sum = 0.0;
+    for (float ms : frameMs) sum += ms;
+    double mean = frameMs.empty() ? 0.0 : sum / frameMs.size();
+    double var = 0.0;
+    for (float ms : frameMs) var += (ms - mean) * (ms - mean);
+    double stddev = frameMs.size() > 1 ? std::sqrt(var / (frameMs.size() - 1)) : 0.0;
+
+    std::ofstream out(path);
+    if (!out) return false;
+
+    out << "{\n";
+    out << "  \"renderer\": \"" << jsonEscape(renderer) << "\",\n";
+    out << "  \"frames\": " << frameMs.size() << ",\n";
+    out << "  \"warmup_frames\": " << options.warmupFrames << ",\n";
+    out << "  \"fixed_dt\": " << options.dt << ",\n";
+    out << "  \"frame_ms\": {\n";
+    out << "    \"mean\": " << mean << ",\n";
+    out << "    \"stddev\": " << stddev << ",\n";
+    out << "    \"min\": " << (sorted.empty() ? 0.0f : sorted.front()) << ",\n";
+    out << "    \"p50\": " << percentile(sorted, 0.50f) << ",\n";
+    out << "    \"p95\": " << percentile(sorted, 0.95f) << ",\n";
+    out << "    \"p99\": " << percentile(sorted, 0.99f) << ",\n";
+    out << "    \"max\": " << (sorted.empty() ? 0.0f : sorted.back()) << "\n";
+    out << "  },\n";
+
+    // Per-phase means so a regression can be pinned to one scenario
+    out << "  \"phase_mean_ms\": {";
+    int perPhase = options.frames / PhaseCount;
+    for (int p = 0; p < PhaseCount; ++p) {
+        size_t begin = std::min(frameMs.size(), (size_t)(p * perPhase));
+        size_t end = p == PhaseCount - 1 ? frameMs.size() : std::min(frameMs.size(), (size_t)((p + 1) * perPhase));
+        double phaseSum = 0.0;
+        for (size_t i = begin; i < end; ++i) phaseSum += frameMs[i];
+        out << (p ? ", " : " ") << "\"" << benchPhaseName((BenchPhase)p) << "\": "
+            << (end > begin ? phaseSum / (end - begin) : 0.0);
+    }
+    out << " },\n";
+
+    out << "  \"load_s\": {";
+    for (size_t i = 0; i < loadTimings.size(); ++i) {
+        out << (i ? ", " : " ") << "\"" << jsonEscape(loadTimings[i].first) << "\": "
+            << loadTimings[i].second;
+    }
+    out << " }\n";
+    out << "}\n";
+    return (bool)out;
+}
@@ -0,0 +1,69 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+// Headless benchmark run of the app: offscreen, vsync off, fixed dt and a
+// scripted scenario so two runs on the same machine are comparable.
+//
+//   app --bench [--bench-frames N] [--bench-warmup N] [--bench-dt S]
+//       [--bench-out path.json]
+struct BenchOptions {
+    bool enabled = false;
+    int frames = 900;           // measured frames, split over the phases
+    int warmupFrames = 60;      // after streaming finished, not recorded
+    float dt = 1.0f / 60.0f;
+    std::string outPath = "bench.json";
+};
+
+BenchOptions parseBenchOptions(int argc, char** argv);
+
+// Call before the window is created. Hides the window and, with no
+// display server and GLFW 3.4+, picks the null platform with an EGL
+// context (e.g. Mesa llvmpipe via EGL_PLATFORM=surfaceless).
+void prepareHeadlessWindow();
+
+enum class BenchPhase {
+    Keyframes,   // keyframed flight, free camera
+    Cinema,      // keyframed flight, cinema camera
+    Quaternion   // quaternion mode driven by scripted input
+};
+
+// Frame counter for the scripted scenario
+class BenchScenario {
+public:
+    explicit BenchScenario(const BenchOptions& options);
+
+    // Call once per frame after rendering; warm-up starts counting only
+    // once ready is true (everything streamed in)
+    void advance(bool ready, float frameMs);
+
+    bool warmingUp() const { return warmup > 0 || !started; }
+    bool done() const { return (int)frameMs.size() >= options.frames; }
+    BenchPhase phase() const;
+    // Measured frames since the current phase began
+    int phaseFrame() const;
+
+    const std::vector<float>& samples() const { return frameMs; }
+
+private:
+    BenchOptions options;
+    int warmup;
+    bool started = false;
+    std::vector<float> frameMs;
+};
+
+const char* benchPhaseName(BenchPhase phase);
+
+// Frame-time summary plus named load timings (seconds) as JSON
+bool writeBenchJson(const std::string& path, const BenchOptions& options,
+    const std::vector<float>& frameMs,
+    const std::vector<std::pair<std::string, float>>& loadTimings,
+    const std::string& renderer);
@@ -0,0 +1,150 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#include "Bounds.h"
+
+#include <cmath>
+
+#ifdef RTA_SSE
+#include <emmintrin.h>
+#endif
+
+// -------------------- Aabb --------------------
+
+float Aabb::surfaceArea() const {
+    if (empty()) return 0.0f;
+    glm::vec3 d = max - min;
+    return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+}
+
+void Aabb::grow(const glm::vec3& p) {
+    min = glm::min(min, p);
+    max = glm::max(max, p);
+}
+
+void Aabb::grow(const Aabb& b) {
+    min = glm::min(min, b.min);
+    max = glm::max(max, b.max);
+}
+
+Aabb transformAabb(const Aabb& local, const glm::mat4& m) {
+    if (local.empty()) return local;
+    glm::vec3 center = glm::vec3(m * glm::vec4(local.center(), 1.0f));
+    glm::vec3 e = local.extent();
+
+    // Half-extent through the absolute upper 3x3
+    glm::vec3 extent;
+    for (int row = 0; row < 3; ++row) {
+        extent[row] = std::fabs(m[0][row]) * e.x + std::fabs(m[1][row]) * e.y +
+                      std::fabs(m[2][row]) * e.z;
+    }
+
+    Aabb out;
+    out.min = center - extent;
+    out.max = center + extent;
+    return out;
+}
+
+// -------------------- Frustum --------------------
+
+Frustum Frustum::fromMatrix(const glm::mat4& m) {
+    // glm is column-major, so row i is (m[0][i], m[1][i], m[2][i], m[3][i])
+    auto row = [&m](int i) { return glm::vec4(m[0][i], m[1][i], m[2][i], m[3][i]); };
+    glm::vec4 r0 = row(0), r1 = row(1), r2 = row(2), r3 = row(3);
+
+    Frustum f;
+    f.planes[0] = r3 + r0; // left
+    f.planes[1] = r3 - r0; // right
+    f.planes[2] = r3 + r1; // bottom
+    f.planes[3] = r3 - r1; // top
+    f.planes[4] = r3 + r2; // near
+    f.planes[5] = r3 - r2; // far
+
+    for (int i = 0; i < 6; ++i) f.planes[i] /= glm::length(glm::vec3(f.planes[i]));
+
+    // Padding lanes repeat the far plane so they never reject on their own
+    for (int i = 0; i < 8; ++i) {
+        const glm::vec4& p = f.planes[i < 6 ? i : 5];
+        f.px[i] = p.x;
+        f.py[i] = p.y;
+        f.pz[i] = p.z;
+        f.pw[i] = p.w;
+    }
+    return f;
+}
+
+Containment classifyAabb(const Frustum& f, const Aabb& box) {
+    glm::vec3 c = box.center();
+    glm::vec3 e = box.extent();
+    bool inside = true;
+
+#ifdef RTA_SSE
+    const __m128 cx = _mm_set1_ps(c.x), cy = _mm_set1_ps(c.y), cz = _mm_set1_ps(c.z);
+    const __m128 ex = _mm_set1_ps(e.x), ey = _mm_set1_ps(e.y), ez = _mm_set1_ps(e.z);
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    const __m128 zero = _mm_setzero_ps();
+
+    // Four planes per pass: centre distance d and box radius r along each normal
+    for (int i = 0; i < 8; i += 4) {
+        __m128 nx = _mm_load_ps(f.px + i), ny = _mm_load_ps(f.py + i);
+        __m128 nz = _mm_load_ps(f.pz + i), nw = _mm_load_ps(f.pw + i);
+
+        __m128 d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, cx), _mm_mul_ps(ny, cy)),
+                              _mm_add_ps(_mm_mul_ps(nz, cz), nw));
+        __m128 r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_and_ps(nx, absMask), ex),
+                                         _mm_mul_ps(_mm_and_ps(ny, absMask), ey)),
+                              _mm_mul_ps(_mm_and_ps(nz, absMask), ez));
+
+        if (_mm_movemask_ps(_mm_cmplt_ps(_mm_add_ps(d, r), zero))) return Containment::Outside;
+        if (_mm_movemask_ps(_mm_cmplt_ps(_mm_sub_ps(d, r), zero))) inside = false;
+    }
+#else
+    for (int i = 0; i < 6; ++i) {
+        const glm::vec4& p = f.planes[i];
+        float d = p.x * c.x + p.y * c.y + p.z * c.z + p.w;
+        float r = std::fabs(p.x) * e.x + std::fabs(p.y) * e.y + std::fabs(p.z) * e.z;
+        if (d + r < 0.0f) return Containment::Outside;
+        if (d - r < 0.0f) inside = false;
+    }
+#endif
+    return inside ? Containment::Inside : Containment::Intersects;
+}
+
+void cullSpheres(const Frustum& f, const glm::vec4* spheres, std::size_t count,
+    std::uint8_t* visible) {
+    std::size_t i = 0;
+
+#ifdef RTA_SSE
+    const __m128 zero = _mm_setzero_ps();
+    for (; i + 4 <= count; i += 4) {
+        const float* s = &spheres[i].x;
+        __m128 x = _mm_loadu_ps(s), y = _mm_loadu_ps(s + 4);
+        __m128 z = _mm_loadu_ps(s + 8), r = _mm_loadu_ps(s + 12);
+        _MM_TRANSPOSE4_PS(x, y, z, r);
+
+        __m128 outside = zero;
+        for (int p = 0; p < 6; ++p) {
+            __m128 d = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(_mm_set1_ps(f.px[p]), x), _mm_mul_ps(_mm_set1_ps(f.py[p]), y)),
+                _mm_add_ps(_mm_mul_ps(_mm_set1_ps(f.pz[p]), z), _mm_set1_ps(f.pw[p])));
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(d, r), zero));
+        }
+
+        int mask = _mm_movemask_ps(outside);
+        for (int k = 0; k < 4; ++k) visible[i + k] = (mask >> k) & 1 ? 0 : 1;
+    }
+#endif
+
+    for (; i < count; ++i) {
+        const glm::vec4& s = spheres[i];
+        bool in = true;
+        for (int p = 0; p < 6 && in; ++p) {
+            const glm::vec4& pl = f.planes[p];
+            in = pl.x * s.x + pl.y * s.y + pl.z * s.z + pl.w + s.w >= 0.0f;
+        }
+        visible[i] = in ? 1 : 0;
+    }
+}
@@ -0,0 +1,52 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+#include "SimdConfig.h"
+
+// Axis-aligned box; starts empty so grow() can build it from nothing
+struct Aabb {
+    glm::vec3 min = glm::vec3(1e30f);
+    glm::vec3 max = glm::vec3(-1e30f);
+
+    bool empty() const { return min.x > max.x; }
+    glm::vec3 center() const { return (min + max) * 0.5f; }
+    glm::vec3 extent() const { return (max - min) * 0.5f; }
+    float surfaceArea() const;
+
+    void grow(const glm::vec3& p);
+    void grow(const Aabb& b);
+};
+
+// Box around a local-space box after an affine transform (Arvo)
+Aabb transformAabb(const Aabb& local, const glm::mat4& m);
+
+// Six inward-facing planes (xyz normal, w distance) pulled out of a
+// projection * view matrix (Gribb-Hartmann). Also kept as x/y/z/w lanes,
+// padded to 8, for the SSE tests.
+struct Frustum {
+    glm::vec4 planes[6];
+    alignas(16) float px[8], py[8], pz[8], pw[8];
+
+    static Frustum fromMatrix(const glm::mat4& viewProj);
+};
+
+enum class Containment { Outside, Intersects, Inside };
+
+Containment classifyAabb(const Frustum& frustum, const Aabb& box);
+inline bool aabbVisible(const Frustum& frustum, const Aabb& box) {
+    return classifyAabb(frustum, box) != Containment::Outside;
+}
+
+// visible[i] = 1 if sphere i (xyz centre, w radius) touches the frustum.
+// Four spheres per iteration with SSE, scalar for the tail.
+void cullSpheres(const Frustum& frustum, const glm::vec4* spheres, std::size_t count,
+    std::uint8_t* visible);
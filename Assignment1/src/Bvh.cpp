@@ -0,0 +1,132 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#include "Bvh.h"
+
+#include <algorithm>
+
+// -------------------- Build --------------------
+
+void Bvh::build(const std::vector<Aabb>& boxes) {
+    nodes.clear();
+    itemBoxes.clear();
+    items.resize(boxes.size());
+    centroids.resize(boxes.size());
+    for (std::uint32_t i = 0; i < (std::uint32_t)boxes.size(); ++i) {
+        items[i] = i;
+        centroids[i] = boxes[i].center();
+    }
+    if (boxes.empty()) return;
+
+    // Children are always allocated after their parent, so a reverse walk
+    // over nodes visits children before parents (used by update)
+    nodes.reserve(boxes.size() / LeafSize * 2 + 1);
+    Node root;
+    root.count = (std::uint32_t)boxes.size();
+    nodes.push_back(root);
+    split(0, boxes);
+
+    itemBoxes.resize(items.size());
+    for (std::size_t i = 0; i < items.size(); ++i) itemBoxes[i] = boxes[items[i]];
+
+    builtCost = cost();
+    rebuilds++;
+}
+
+void Bvh::split(std::uint32_t index, const std::vector<Aabb>& boxes) {
+    Node node = nodes[index];
+    Aabb centreBounds;
+    for (std::uint32_t i = node.first; i < node.first + node.count; ++i) {
+        node.box.grow(boxes[items[i]]);
+        centreBounds.grow(centroids[items[i]]);
+    }
+
+    if (node.count > LeafSize) {
+        glm::vec3 size = centreBounds.max - centreBounds.min;
+        int axis = size.x > size.y ? (size.x > size.z ? 0 : 2) : (size.y > size.z ? 1 : 2);
+
+        std::uint32_t half = node.count / 2;
+        auto begin = items.begin() + node.first;
+        std::nth_element(begin, begin + half, begin + node.count,
+            [this, axis](std::uint32_t a, std::uint32_t b) { return centroids[a][axis] < centroids[b][axis]; });
+
+        node.left = (std::uint32_t)nodes.size();
+        Node left, right;
+        left.first = node.first;
+        left.count = half;
+        right.first = node.first + half;
+        right.count = node.count - half;
+        nodes.push_back(left);
+        nodes.push_back(right);
+        nodes[index] = node;
+        split(node.left, boxes);
+        split(node.left + 1, boxes);
+        return;
+    }
+    nodes[index] = node;
+}
+
+// -------------------- Refit --------------------
+
+void Bvh::update(const std::vector<Aabb>& boxes) {
+    if (boxes.size() != items.size() || nodes.empty()) {
+        build(boxes);
+        return;
+    }
+
+    for (std::size_t n = nodes.size(); n-- > 0;) {
+        Node& node = nodes[n];
+        node.box = Aabb();
+        if (node.left) {
+            node.box.grow(nodes[node.left].box);
+            node.box.grow(nodes[node.left + 1].box);
+        } else {
+            for (std::uint32_t i = node.first; i < node.first + node.count; ++i) {
+                itemBoxes[i] = boxes[items[i]];
+                node.box.grow(itemBoxes[i]);
+            }
+        }
+    }
+
+    if (cost() > builtCost * RebuildRatio) build(boxes);
+}
+
+float Bvh::cost() const {
+    if (nodes.empty()) return 0.0f;
+    float rootArea = nodes[0].box.surfaceArea();
+    if (rootArea <= 0.0f) return 0.0f;
+    float total = 0.0f;
+    for (const Node& node : nodes) total += node.box.surfaceArea();
+    return total / rootArea;
+}
+
+// -------------------- Query --------------------
+
+void Bvh::cull(const Frustum& frustum, std::vector<std::uint32_t>& visible) const {
+    if (nodes.empty()) return;
+
+    std::uint32_t stack[64];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        const Node& node = nodes[stack[--top]];
+        Containment c = classifyAabb(frustum, node.box);
+        if (c == Containment::Outside) continue;
+
+        if (c == Containment::Inside) {
+            visible.insert(visible.end(), items.begin() + node.first,
+                items.begin() + node.first + node.count);
+            continue;
+        }
+        if (!node.left) {
+            for (std::uint32_t i = node.first; i < node.first + node.count; ++i)
+                if (aabbVisible(frustum, itemBoxes[i])) visible.push_back(items[i]);
+            continue;
+        }
+        stack[top++] = node.left;
+        stack[top++] = node.left + 1;
+    }
+}
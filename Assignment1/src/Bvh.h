@@ -0,0 +1,53 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Bounds.h"
+
+// Bounding volume hierarchy over a list of world-space boxes, one per
+// scene instance. Built top-down with a median split on the longest axis.
+// For animated instances call update() every frame: it refits the node
+// boxes bottom-up and only rebuilds once refitting has made the tree
+// noticeably looser than it was when built.
+class Bvh {
+public:
+    static constexpr std::uint32_t LeafSize = 4;
+    static constexpr float RebuildRatio = 1.5f;
+
+    void build(const std::vector<Aabb>& boxes);
+    // Refit to moved boxes; rebuilds if the count changed or the tree degraded
+    void update(const std::vector<Aabb>& boxes);
+
+    // Appends the index of every box that touches the frustum, in no
+    // particular order. Subtrees fully inside are taken without testing.
+    void cull(const Frustum& frustum, std::vector<std::uint32_t>& visible) const;
+
+    std::size_t nodeCount() const { return nodes.size(); }
+    int rebuildCount() const { return rebuilds; }
+    // Summed node surface area over the root's; lower is tighter
+    float cost() const;
+
+private:
+    struct Node {
+        Aabb box;
+        std::uint32_t left = 0;  // first of two children (right = left + 1), 0 for a leaf
+        std::uint32_t first = 0; // item range covered by this subtree
+        std::uint32_t count = 0;
+    };
+
+    void split(std::uint32_t node, const std::vector<Aabb>& boxes);
+
+    std::vector<Node> nodes;
+    std::vector<std::uint32_t> items;     // box indices, grouped by subtree
+    std::vector<Aabb> itemBoxes;          // boxes in items order, for leaf tests
+    std::vector<glm::vec3> centroids;     // scratch for build
+    float builtCost = 0.0f;
+    int rebuilds = 0;
+};
@@ -0,0 +1,266 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#include "ClusteredLights.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "Bounds.h"
+
+namespace {
+
+const GLenum TexelFormats[3] = { GL_RGBA32F, GL_RG32UI, GL_R16UI };
+
+// Tightest simple sphere around a light's lit volume. A spot light lights
+// a cone capped at its range: narrow cones get the sphere through the apex
+// and the rim, wide ones the sphere around the rim.
+glm::vec4 lightSphere(const Light& light) {
+    float cosA = light.outerCos;
+    if (cosA <= 0.0f) return glm::vec4(light.position, light.range);
+    if (cosA < 0.70710678f) {
+        float sinA = std::sqrt(1.0f - cosA * cosA);
+        return glm::vec4(light.position + light.direction * (light.range * cosA), light.range * sinA);
+    }
+    float radius = light.range / (2.0f * cosA);
+    return glm::vec4(light.position + light.direction * radius, radius);
+}
+
+glm::vec4 normalizePlane(const glm::vec4& plane) {
+    return plane * (1.0f / glm::length(glm::vec3(plane)));
+}
+
+// First and last of tiles whose bounding planes (tiles + 1 of them, in
+// order) the sphere reaches the inner side of; false if none
+bool tileSpan(const glm::vec4* planes, int tiles, const glm::vec4& center, float radius,
+    std::uint8_t& first, std::uint8_t& last) {
+    int lo = -1, hi = -1;
+    for (int i = 0; i < tiles; ++i) {
+        if (glm::dot(planes[i], center) < -radius || glm::dot(planes[i + 1], center) > radius) continue;
+        if (lo < 0) lo = i;
+        hi = i;
+    }
+    if (lo < 0) return false;
+    first = (std::uint8_t)lo;
+    last = (std::uint8_t)hi;
+    return true;
+}
+
+void uploadBuffer(GLenum target, GLuint buffer, std::size_t& capacity,
+    std::vector<unsigned char>& uploaded, const void* data, std::size_t bytes) {
+    if (bytes == uploaded.size() && (bytes == 0 || std::memcmp(uploaded.data(), data, bytes) == 0))
+        return;
+    uploaded.assign((const unsigned char*)data, (const unsigned char*)data + bytes);
+
+    glBindBuffer(target, buffer);
+    // Orphan the old store so the driver never waits on last frame's reads
+    capacity = std::max(capacity, bytes);
+    glBufferData(target, (GLsizeiptr)capacity, nullptr, GL_STREAM_DRAW);
+    if (bytes) glBufferSubData(target, 0, (GLsizeiptr)bytes, data);
+}
+
+} // namespace
+
+void ClusteredLights::create() {
+    glGenBuffers(1, &ubo);
+    glBindBuffer(GL_UNIFORM_BUFFER, ubo);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(ClusterUniformData), &uniforms, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    glBindBufferBase(GL_UNIFORM_BUFFER, Binding, ubo);
+
+    glGenBuffers(3, buffers);
+    glGenTextures(3, textures);
+    for (int i = 0; i < 3; ++i) {
+        capacity[i] = 16;
+        glBindBuffer(GL_TEXTURE_BUFFER, buffers[i]);
+        glBufferData(GL_TEXTURE_BUFFER, (GLsizeiptr)capacity[i], nullptr, GL_STREAM_DRAW);
+        glBindTexture(GL_TEXTURE_BUFFER, textures[i]);
+        glTexBuffer(GL_TEXTURE_BUFFER, TexelFormats[i], buffers[i]);
+    }
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+    sliceRects.resize(Slices);
+    sliceIndices.resize(Slices);
+    sliceOverflow.resize(Slices);
+    clusterRanges.resize(ClusterCount * 2);
+}
+
+void ClusteredLights::Delete() {
+    if (ubo) glDeleteBuffers(1, &ubo);
+    if (buffers[0]) glDeleteBuffers(3, buffers);
+    if (textures[0]) glDeleteTextures(3, textures);
+    ubo = 0;
+    std::memset(buffers, 0, sizeof(buffers));
+    std::memset(textures, 0, sizeof(textures));
+    for (std::vector<unsigned char>& bytes : uploaded) bytes.clear();
+    uniforms = uploadedUniforms = ClusterUniformData();
+}
+
+void ClusteredLights::update(const std::vector<Light>& lights, const glm::mat4& viewProj,
+    const glm::vec3& cameraPos, const glm::vec3& cameraForward, float nearPlane, float farPlane,
+    ThreadPool& pool) {
+    const std::size_t count = std::min(lights.size(), (std::size_t)MaxLights);
+    // Off: the shader reads nothing but the switch
+    if (count == 0) {
+        uniforms.grid.w = 0.0f;
+        visible.clear();
+        indices.clear();
+        visibleCount = 0;
+        overflowCount = 0;
+        upload();
+        return;
+    }
+
+    const glm::vec3 forward = glm::normalize(cameraForward);
+    const float sliceScale = Slices / std::log(farPlane / nearPlane);
+    uniforms.grid = glm::vec4(TilesX, TilesY, Slices, 1.0f);
+    uniforms.depth = glm::vec4(nearPlane, sliceScale, 0.0f, 0.0f);
+    uniforms.forward = glm::vec4(forward, 0.0f);
+
+    // Frustum cull the lights' bounding spheres
+    spheres.resize(count);
+    inFrustum.resize(count);
+    for (std::size_t i = 0; i < count; ++i) spheres[i] = lightSphere(lights[i]);
+    cullSpheres(Frustum::fromMatrix(viewProj), spheres.data(), count, inFrustum.data());
+    visible.clear();
+    for (std::size_t i = 0; i < count; ++i)
+        if (inFrustum[i]) visible.push_back((int)i);
+    visibleCount = (int)visible.size();
+
+    // Planes between tile columns and rows, from the clip-space rows:
+    // clip.x - a * clip.w >= 0 is the side with ndc x >= a
+    const glm::vec4 rowX(viewProj[0][0], viewProj[1][0], viewProj[2][0], viewProj[3][0]);
+    const glm::vec4 rowY(viewProj[0][1], viewProj[1][1], viewProj[2][1], viewProj[3][1]);
+    const glm::vec4 rowW(viewProj[0][3], viewProj[1][3], viewProj[2][3], viewProj[3][3]);
+    glm::vec4 columnPlanes[TilesX + 1], rowPlanes[TilesY + 1];
+    for (int i = 0; i <= TilesX; ++i) columnPlanes[i] = normalizePlane(rowX - rowW * (-1.0f + 2.0f * i / TilesX));
+    for (int i = 0; i <= TilesY; ++i) rowPlanes[i] = normalizePlane(rowY - rowW * (-1.0f + 2.0f * i / TilesY));
+
+    // Depth slices each light spans, matching how scene.frag picks its
+    // slice; also packs the visible lights for upload
+    depths.resize(visible.size());
+    sliceSpans.resize(visible.size());
+    lightTexels.resize(visible.size() * 3);
+    auto sliceOf = [&](float depth) {
+        if (depth <= nearPlane) return 0;
+        return glm::clamp((int)(std::log(depth / nearPlane) * sliceScale), 0, Slices - 1);
+    };
+    pool.parallelFor(visible.size(), [&](std::size_t begin, std::size_t end) {
+        for (std::size_t k = begin; k < end; ++k) {
+            const Light& light = lights[visible[k]];
+            lightTexels[k * 3 + 0] = glm::vec4(light.position, light.range);
+            lightTexels[k * 3 + 1] = glm::vec4(light.color, light.outerCos);
+            lightTexels[k * 3 + 2] = glm::vec4(light.direction, light.innerCos);
+
+            const glm::vec4& sphere = spheres[visible[k]];
+            depths[k] = glm::dot(glm::vec3(sphere) - cameraPos, forward);
+            sliceSpans[k][0] = (std::uint8_t)sliceOf(depths[k] - sphere.w);
+            sliceSpans[k][1] = (std::uint8_t)sliceOf(depths[k] + sphere.w);
+        }
+    });
+
+    // One slice per job. Each light is cut down to its part inside the
+    // slice, its tiles found against the column and row planes, then the
+    // slice's clusters are counted, capped and filled. Slices own their
+    // lists, so no job writes where another does.
+    const int tilesPerSlice = TilesX * TilesY;
+    pool.parallelFor(Slices, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t s = begin; s < end; ++s) {
+            // Slice 0 also takes everything nearer, the last everything further
+            float zLo = s == 0 ? -1e30f : nearPlane * std::exp(s / sliceScale);
+            float zHi = s + 1 == Slices ? 1e30f : nearPlane * std::exp((s + 1) / sliceScale);
+
+            std::vector<TileRect>& rects = sliceRects[s];
+            rects.clear();
+            std::uint32_t counts[TilesX * TilesY] = {};
+            for (std::size_t k = 0; k < visible.size(); ++k) {
+                if (s < sliceSpans[k][0] || s > sliceSpans[k][1]) continue;
+
+                // Sphere around the light's part inside the slab
+                const glm::vec4& sphere = spheres[visible[k]];
+                float depth = glm::clamp(depths[k], zLo, zHi);
+                float dz = depth - depths[k];
+                float radius = std::sqrt(std::max(sphere.w * sphere.w - dz * dz, 0.0f));
+                glm::vec4 center(glm::vec3(sphere) + forward * dz, 1.0f);
+
+                // Tiles between planes the sphere reaches both sides of
+                TileRect rect;
+                if (!tileSpan(columnPlanes, TilesX, center, radius, rect.x0, rect.x1) ||
+                    !tileSpan(rowPlanes, TilesY, center, radius, rect.y0, rect.y1))
+                    continue;
+                rect.light = (std::uint16_t)k;
+                rects.push_back(rect);
+                for (int y = rect.y0; y <= rect.y1; ++y)
+                    for (int x = rect.x0; x <= rect.x1; ++x) counts[y * TilesX + x]++;
+            }
+
+            std::uint32_t* cluster = clusterRanges.data() + s * tilesPerSlice * 2;
+            std::uint32_t total = 0;
+            int dropped = 0;
+            for (int c = 0; c < tilesPerSlice; ++c) {
+                std::uint32_t kept = std::min(counts[c], (std::uint32_t)MaxLightsPerCluster);
+                dropped += (int)(counts[c] - kept);
+                cluster[c * 2] = total;
+                cluster[c * 2 + 1] = kept;
+                counts[c] = 0; // reused as fill cursors
+                total += kept;
+            }
+            sliceOverflow[s] = dropped;
+
+            std::vector<std::uint16_t>& list = sliceIndices[s];
+            list.resize(total);
+            for (const TileRect& rect : rects) {
+                for (int y = rect.y0; y <= rect.y1; ++y) {
+                    for (int x = rect.x0; x <= rect.x1; ++x) {
+                        int c = y * TilesX + x;
+                        if (counts[c] < cluster[c * 2 + 1]) list[cluster[c * 2] + counts[c]++] = rect.light;
+                    }
+                }
+            }
+        }
+    });
+
+    // Stitch the slices into one index list
+    indices.clear();
+    overflowCount = 0;
+    for (int s = 0; s < Slices; ++s) {
+        std::uint32_t base = (std::uint32_t)indices.size();
+        std::uint32_t* cluster = clusterRanges.data() + s * tilesPerSlice * 2;
+        for (int c = 0; c < tilesPerSlice; ++c) cluster[c * 2] += base;
+        indices.insert(indices.end(), sliceIndices[s].begin(), sliceIndices[s].end());
+        overflowCount += sliceOverflow[s];
+    }
+
+    upload();
+}
+
+void ClusteredLights::upload() {
+    if (std::memcmp(&uniforms, &uploadedUniforms, sizeof(uniforms)) != 0) {
+        glBindBuffer(GL_UNIFORM_BUFFER, ubo);
+        glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(ClusterUniformData), &uniforms);
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+        uploadedUniforms = uniforms;
+    }
+    if (uniforms.grid.w == 0.0f) return;
+
+    uploadBuffer(GL_TEXTURE_BUFFER, buffers[0], capacity[0], uploaded[0], lightTexels.data(),
+        lightTexels.size() * sizeof(glm::vec4));
+    uploadBuffer(GL_TEXTURE_BUFFER, buffers[1], capacity[1], uploaded[1], clusterRanges.data(),
+        clusterRanges.size() * sizeof(std::uint32_t));
+    uploadBuffer(GL_TEXTURE_BUFFER, buffers[2], capacity[2], uploaded[2], indices.data(),
+        indices.size() * sizeof(std::uint16_t));
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+}
+
+void ClusteredLights::bind() const {
+    const GLint units[3] = { LightUnit, RangeUnit, IndexUnit };
+    for (int i = 0; i < 3; ++i) {
+        glActiveTexture(GL_TEXTURE0 + units[i]);
+        glBindTexture(GL_TEXTURE_BUFFER, textures[i]);
+    }
+    glActiveTexture(GL_TEXTURE0);
+}
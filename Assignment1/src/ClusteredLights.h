@@ -0,0 +1,107 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include "ThreadPool.h"
+
+// Point light, or a spot light when outerCos > -1
+struct Light {
+    glm::vec3 position = glm::vec3(0.0f);
+    float range = 1.0f;                    // no contribution past this
+    glm::vec3 color = glm::vec3(1.0f);     // intensity applied
+    glm::vec3 direction = glm::vec3(0.0f, -1.0f, 0.0f); // spot axis, unit
+    float outerCos = -2.0f;                // cone edge; -2 for point lights
+    float innerCos = -1.0f;                // full intensity inside this
+};
+
+// Mirrors the std140 "ClusterData" block in scene.frag
+struct ClusterUniformData {
+    glm::vec4 grid;    // tiles x, tiles y, depth slices, 1 if enabled
+    glm::vec4 depth;   // near plane, slices / log(far / near)
+    glm::vec4 forward; // xyz, camera view direction
+};
+static_assert(sizeof(ClusterUniformData) == 48, "ClusterUniformData must match std140 layout");
+
+// Clustered forward lighting. The view frustum is cut into screen tiles
+// and exponential depth slices; every frame each light's bounds are
+// mapped to the clusters they touch, on the thread pool one slice at a
+// time, and the per-cluster light lists go to the GPU in texture buffers.
+// scene.frag then loops over its own cluster's list only, which is capped
+// at MaxLightsPerCluster so per-fragment cost stays bounded.
+class ClusteredLights {
+public:
+    static constexpr int TilesX = 16;
+    static constexpr int TilesY = 9;
+    static constexpr int Slices = 24;
+    static constexpr int ClusterCount = TilesX * TilesY * Slices;
+    static constexpr int MaxLightsPerCluster = 64;
+    static constexpr int MaxLights = 65535; // 16-bit indices
+
+    static constexpr GLuint Binding = 1;
+    static constexpr const char* BlockName = "ClusterData";
+    // Texture units of the lightData / clusterRanges / lightIndices samplers
+    static constexpr GLint LightUnit = 4;
+    static constexpr GLint RangeUnit = 5;
+    static constexpr GLint IndexUnit = 6;
+
+    void create();
+    void Delete();
+
+    // Assigns lights to clusters for this camera and uploads whatever
+    // changed. An empty list switches clustered lighting off in the shader
+    // and skips the assignment.
+    void update(const std::vector<Light>& lights, const glm::mat4& viewProj,
+        const glm::vec3& cameraPos, const glm::vec3& cameraForward,
+        float nearPlane, float farPlane, ThreadPool& pool);
+    // Binds the buffers to their texture units
+    void bind() const;
+
+    int visibleLights() const { return visibleCount; }
+    int indexCount() const { return (int)indices.size(); }
+    // Light-cluster pairs dropped by the per-cluster cap last frame
+    int overflow() const { return overflowCount; }
+
+private:
+    // Tiles a light touches within one slice, inclusive
+    struct TileRect {
+        std::uint16_t light; // visible light index
+        std::uint8_t x0, x1, y0, y1;
+    };
+
+    void upload();
+
+    GLuint ubo = 0;
+    GLuint buffers[3] = {};  // lights, cluster ranges, indices
+    GLuint textures[3] = {};
+    std::size_t capacity[3] = {};
+    // Contents as last uploaded; unchanged data is not sent again
+    std::vector<unsigned char> uploaded[3];
+    ClusterUniformData uploadedUniforms = {};
+
+    // Per-frame scratch, kept to avoid reallocating
+    std::vector<glm::vec4> spheres;
+    std::vector<std::uint8_t> inFrustum;
+    std::vector<int> visible;          // compact index -> light
+    std::vector<float> depths;         // view depth per visible light
+    std::vector<std::array<std::uint8_t, 2>> sliceSpans; // first, last slice
+    std::vector<glm::vec4> lightTexels;
+    std::vector<std::vector<TileRect>> sliceRects;
+    std::vector<std::vector<std::uint16_t>> sliceIndices;
+    std::vector<int> sliceOverflow;
+    std::vector<std::uint32_t> clusterRanges; // first, count per cluster
+    std::vector<std::uint16_t> indices;
+
+    ClusterUniformData uniforms = {};
+    int visibleCount = 0;
+    int overflowCount = 0;
+};
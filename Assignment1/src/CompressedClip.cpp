@@ -0,0 +1,423 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#include "CompressedClip.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+#include "FileUtils.h"
+
+namespace {
+
+const char ClipMagic[8] = { 'R', 'T', 'A', 'C', 'L', 'I', 'P', '\0' };
+
+// Smallest-three components lie in [-1/sqrt2, 1/sqrt2]
+const float InvSqrt2 = 0.707106781f;
+const float RotationSteps = 32767.0f;
+
+glm::quat nlerp(const glm::quat& a, const glm::quat& b, float t) {
+    float s = glm::dot(a, b) < 0.0f ? -t : t;
+    float r = 1.0f - t;
+    glm::quat q(a.w * r + b.w * s, a.x * r + b.x * s, a.y * r + b.y * s, a.z * r + b.z * s);
+    return q * (1.0f / std::sqrt(glm::dot(q, q)));
+}
+
+// Largest block extent whose 16-bit quantisation error stays within a
+// quarter of the position bound: sqrt(3) * extent / 65535 / 2 <= bound / 4
+float maxBlockExtent(float positionError) {
+    return positionError * 65535.0f / (2.0f * 1.7320508f);
+}
+
+// Angle in radians between two rotations, from the chord between the
+// quaternions: acos of a dot product near 1 is too coarse in float
+float rotationAngle(const glm::quat& a, const glm::quat& b) {
+    float s = glm::dot(a, b) < 0.0f ? -1.0f : 1.0f;
+    glm::vec4 d(a.x - s * b.x, a.y - s * b.y, a.z - s * b.z, a.w - s * b.w);
+    return 4.0f * std::asin(std::min(glm::length(d) * 0.5f, 1.0f));
+}
+
+} // namespace
+
+// -------------------- Compression --------------------
+
+CompressedClip::CompressedClip(const std::vector<Keyframe>& keys,
+    const ClipCompressionSettings& settings) {
+    const std::size_t n = keys.size();
+    if (n == 0) return;
+
+    // Cut the input into blocks small enough to quantise to 16 bits
+    const float posBound = std::max(settings.positionError, 1e-6f);
+    const float rotBound = std::max(glm::radians(settings.rotationError), 1e-6f);
+    const float blockExtent = maxBlockExtent(posBound);
+    std::vector<std::uint16_t> inputBlock(n);
+    std::vector<ClipBlock> inputBlocks;
+    glm::vec3 lo = keys[0].position, hi = keys[0].position;
+    std::size_t blockStart = 0;
+    for (std::size_t i = 0; i <= n; ++i) {
+        if (i < n) {
+            glm::vec3 newLo = glm::min(lo, keys[i].position), newHi = glm::max(hi, keys[i].position);
+            glm::vec3 extent = newHi - newLo;
+            bool fits = std::max(extent.x, std::max(extent.y, extent.z)) <= blockExtent ||
+                        inputBlocks.size() == 0xFFFF;
+            if (fits || i == blockStart) {
+                lo = newLo;
+                hi = newHi;
+                continue;
+            }
+        }
+        ClipBlock block;
+        block.rangeMin = lo;
+        block.rangeScale = (hi - lo) / 65535.0f;
+        for (std::size_t k = blockStart; k < i; ++k) inputBlock[k] = (std::uint16_t)inputBlocks.size();
+        inputBlocks.push_back(block);
+        if (i < n) {
+            blockStart = i;
+            lo = hi = keys[i].position;
+        }
+    }
+
+    // Work against the quantised keys so the bound covers quantisation too
+    std::vector<PackedKey> encoded(n);
+    std::vector<glm::vec3> position(n);
+    std::vector<glm::quat> rotation(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        const ClipBlock& block = inputBlocks[inputBlock[i]];
+        encoded[i] = encode(block, keys[i].position, keys[i].rotation);
+        position[i] = block.rangeMin + glm::vec3(encoded[i].position[0], encoded[i].position[1],
+            encoded[i].position[2]) * block.rangeScale;
+        rotation[i] = decodeRotation(encoded[i]);
+    }
+
+    // Douglas-Peucker over time: keep the worst key of a span until every
+    // dropped key is within bounds of the interpolation across its span
+    std::vector<char> keep(n, 0);
+    keep[0] = keep[n - 1] = 1;
+
+    std::vector<std::pair<std::size_t, std::size_t>> spans;
+    if (n > 2) spans.push_back({ 0, n - 1 });
+    while (!spans.empty()) {
+        auto span = spans.back();
+        spans.pop_back();
+        std::size_t a = span.first, b = span.second;
+        float duration = keys[b].time - keys[a].time;
+
+        float worst = 1.0f;
+        std::size_t worstKey = 0;
+        for (std::size_t k = a + 1; k < b; ++k) {
+            float t = duration > 0.0f ? (keys[k].time - keys[a].time) / duration : 0.0f;
+            float posErr = glm::length(glm::mix(position[a], position[b], t) - keys[k].position);
+            float rotErr = rotationAngle(nlerp(rotation[a], rotation[b], t), glm::normalize(keys[k].rotation));
+            float err = std::max(posErr / posBound, rotErr / rotBound);
+            if (err > worst) {
+                worst = err;
+                worstKey = k;
+            }
+        }
+        if (worstKey == 0) continue;
+
+        keep[worstKey] = 1;
+        if (worstKey - a > 1) spans.push_back({ a, worstKey });
+        if (b - worstKey > 1) spans.push_back({ worstKey, b });
+    }
+
+    // Blocks left without keys are dropped
+    std::vector<int> blockRemap(inputBlocks.size(), -1);
+    for (std::size_t i = 0; i < n; ++i) {
+        if (!keep[i]) continue;
+        int& block = blockRemap[inputBlock[i]];
+        if (block < 0) {
+            block = (int)blocks.size();
+            blocks.push_back(inputBlocks[inputBlock[i]]);
+        }
+        times.push_back(keys[i].time);
+        packed.push_back(encoded[i]);
+        keyBlock.push_back((std::uint16_t)block);
+    }
+}
+
+PackedKey CompressedClip::encode(const ClipBlock& block, const glm::vec3& p, const glm::quat& q) {
+    PackedKey key;
+    for (int i = 0; i < 3; ++i) {
+        float scale = block.rangeScale[i];
+        float v = scale > 0.0f ? (p[i] - block.rangeMin[i]) / scale : 0.0f;
+        key.position[i] = (std::uint16_t)glm::clamp(v + 0.5f, 0.0f, 65535.0f);
+    }
+
+    glm::quat n = glm::normalize(q);
+    const float c[4] = { n.x, n.y, n.z, n.w };
+    int largest = 0;
+    for (int i = 1; i < 4; ++i)
+        if (std::fabs(c[i]) > std::fabs(c[largest])) largest = i;
+    float sign = c[largest] < 0.0f ? -1.0f : 1.0f; // q and -q are the same rotation
+
+    int slot = 0;
+    for (int i = 0; i < 4; ++i) {
+        if (i == largest) continue;
+        float v = (c[i] * sign * InvSqrt2 + 0.5f) * RotationSteps; // to [0, 32767]
+        key.rotation[slot++] = (std::uint16_t)glm::clamp(v + 0.5f, 0.0f, RotationSteps);
+    }
+    key.rotation[0] |= (std::uint16_t)((largest >> 1) << 15);
+    key.rotation[1] |= (std::uint16_t)((largest & 1) << 15);
+    return key;
+}
+
+// -------------------- Decoding --------------------
+
+glm::vec3 CompressedClip::decodePosition(std::size_t i) const {
+    const ClipBlock& block = blocks[keyBlock[i]];
+    const PackedKey& key = packed[i];
+    return block.rangeMin + glm::vec3(key.position[0], key.position[1], key.position[2]) * block.rangeScale;
+}
+
+glm::quat CompressedClip::decodeRotation(const PackedKey& key) {
+    int largest = ((key.rotation[0] >> 15) << 1) | (key.rotation[1] >> 15);
+    float small[3];
+    float sum = 0.0f;
+    for (int i = 0; i < 3; ++i) {
+        small[i] = ((key.rotation[i] & 0x7FFF) * (1.0f / RotationSteps) - 0.5f) * (2.0f * InvSqrt2);
+        sum += small[i] * small[i];
+    }
+
+    float c[4];
+    int slot = 0;
+    for (int i = 0; i < 4; ++i)
+        c[i] = i == largest ? std::sqrt(std::max(1.0f - sum, 0.0f)) : small[slot++];
+    return glm::quat(c[3], c[0], c[1], c[2]);
+}
+
+Keyframe CompressedClip::key(std::size_t i) const {
+    return { decodePosition(i), decodeRotation(packed[i]), times[i] };
+}
+
+std::size_t CompressedClip::byteSize() const {
+    return times.size() * sizeof(float) + packed.size() * sizeof(PackedKey) +
+           keyBlock.size() * sizeof(std::uint16_t) + blocks.size() * sizeof(ClipBlock);
+}
+
+void CompressedClip::locate(float time, std::size_t& cursor) const {
+    const std::size_t last = times.size() - 2; // last key pair
+    auto contains = [&](std::size_t i) {
+        return time >= times[i] && (i == last || time < times[i + 1]);
+    };
+
+    // Same pair, or the next one; otherwise search
+    if (cursor <= last && contains(cursor)) return;
+    if (cursor < last && contains(cursor + 1)) { ++cursor; return; }
+
+    auto it = std::upper_bound(times.begin(), times.end(), time);
+    cursor = it == times.begin() ? 0 : std::min((std::size_t)(it - times.begin()) - 1, last);
+}
+
+void CompressedClip::sample(float time, std::size_t& cursor, glm::vec3& position,
+    glm::quat& rotation) const {
+    if (empty()) {
+        position = packed.empty() ? glm::vec3(0.0f) : decodePosition(0);
+        rotation = packed.empty() ? glm::quat(1, 0, 0, 0) : decodeRotation(packed[0]);
+        return;
+    }
+
+    time = glm::clamp(time, startTime(), endTime());
+    locate(time, cursor);
+
+    const std::size_t i = cursor;
+    float span = times[i + 1] - times[i];
+    float t = span > 0.0f ? (time - times[i]) / span : 0.0f;
+    position = glm::mix(decodePosition(i), decodePosition(i + 1), t);
+    rotation = nlerp(decodeRotation(packed[i]), decodeRotation(packed[i + 1]), t);
+}
+
+// -------------------- Files --------------------
+
+CompressedClip CompressedClip::slice(std::size_t first, std::size_t last) const {
+    CompressedClip part;
+    if (first > last || last >= packed.size()) return part;
+
+    std::vector<int> blockRemap(blocks.size(), -1);
+    for (std::size_t i = first; i <= last; ++i) {
+        int& block = blockRemap[keyBlock[i]];
+        if (block < 0) {
+            block = (int)part.blocks.size();
+            part.blocks.push_back(blocks[keyBlock[i]]);
+        }
+        part.times.push_back(times[i]);
+        part.packed.push_back(packed[i]);
+        part.keyBlock.push_back((std::uint16_t)block);
+    }
+    return part;
+}
+
+void CompressedClip::append(const CompressedClip& next) {
+    if (next.packed.empty()) return;
+    std::size_t skip = packed.empty() ? 0 : 1;
+
+    // The shared key's block is already ours
+    std::size_t firstBlock = 0;
+    std::size_t blockBase = blocks.size();
+    if (skip && std::memcmp(&next.blocks[0], &blocks.back(), sizeof(ClipBlock)) == 0) {
+        firstBlock = 1;
+        blockBase -= 1;
+    }
+    blocks.insert(blocks.end(), next.blocks.begin() + firstBlock, next.blocks.end());
+    times.insert(times.end(), next.times.begin() + skip, next.times.end());
+    packed.insert(packed.end(), next.packed.begin() + skip, next.packed.end());
+    for (std::size_t i = skip; i < next.keyBlock.size(); ++i)
+        keyBlock.push_back((std::uint16_t)(blockBase + next.keyBlock[i]));
+}
+
+void CompressedClip::writeChunk(std::vector<unsigned char>& bytes) const {
+    auto append = [&bytes](const void* data, std::size_t size) {
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+        bytes.insert(bytes.end(), p, p + size);
+    };
+    const std::uint32_t counts[2] = { (std::uint32_t)packed.size(), (std::uint32_t)blocks.size() };
+    // Largest alignment first, so every array stays naturally aligned
+    append(counts, sizeof(counts));
+    append(blocks.data(), blocks.size() * sizeof(ClipBlock));
+    append(times.data(), times.size() * sizeof(float));
+    append(packed.data(), packed.size() * sizeof(PackedKey));
+    append(keyBlock.data(), keyBlock.size() * sizeof(std::uint16_t));
+}
+
+bool CompressedClip::readChunk(const unsigned char* data, std::size_t size) {
+    *this = CompressedClip();
+    std::uint32_t counts[2];
+    if (size < sizeof(counts)) return false;
+    std::memcpy(counts, data, sizeof(counts));
+    const std::size_t keys = counts[0];
+    std::size_t expected = sizeof(counts) + counts[1] * sizeof(ClipBlock) +
+        keys * (sizeof(float) + sizeof(PackedKey) + sizeof(std::uint16_t));
+    if (expected > size) return false;
+
+    blocks.resize(counts[1]);
+    times.resize(keys);
+    packed.resize(keys);
+    keyBlock.resize(keys);
+    const unsigned char* p = data + sizeof(counts);
+    auto take = [&p](void* dst, std::size_t bytes) {
+        std::memcpy(dst, p, bytes);
+        p += bytes;
+    };
+    take(blocks.data(), blocks.size() * sizeof(ClipBlock));
+    take(times.data(), keys * sizeof(float));
+    take(packed.data(), keys * sizeof(PackedKey));
+    take(keyBlock.data(), keys * sizeof(std::uint16_t));
+
+    for (std::uint16_t block : keyBlock)
+        if (block >= blocks.size()) { *this = CompressedClip(); return false; }
+    return true;
+}
+
+bool CompressedClip::save(const std::string& path) const {
+    if (packed.empty()) return false;
+
+    // Chunk c holds keys c * ChunkKeys up to and including the next
+    // chunk's first key
+    const std::size_t n = packed.size();
+    const std::size_t chunkCount = n < 2 ? 1 : (n - 2) / ChunkKeys + 1;
+
+    ClipFileHeader header = {};
+    std::memcpy(header.magic, ClipMagic, sizeof(ClipMagic));
+    header.version = Version;
+    header.keyCount = (std::uint32_t)n;
+    header.chunkCount = (std::uint32_t)chunkCount;
+    header.chunkKeys = (std::uint32_t)ChunkKeys;
+    header.startTime = startTime();
+    header.endTime = endTime();
+
+    std::vector<ClipChunkEntry> entries(chunkCount);
+    std::vector<unsigned char> bytes(sizeof(header) + chunkCount * sizeof(ClipChunkEntry));
+    for (std::size_t c = 0; c < chunkCount; ++c) {
+        std::size_t first = c * ChunkKeys;
+        std::size_t last = std::min(first + ChunkKeys, n - 1);
+        ClipChunkEntry& entry = entries[c];
+        entry.startTime = times[first];
+        entry.endTime = times[last];
+        entry.offset = bytes.size();
+        entry.keyCount = (std::uint32_t)(last - first + 1);
+        slice(first, last).writeChunk(bytes);
+        entry.size = (std::uint32_t)(bytes.size() - entry.offset);
+    }
+    std::memcpy(bytes.data(), &header, sizeof(header));
+    std::memcpy(bytes.data() + sizeof(header), entries.data(), chunkCount * sizeof(ClipChunkEntry));
+    return writeFileAtomic(path, bytes.data(), bytes.size());
+}
+
+bool readClipHeader(const MappedFile& file, ClipFileHeader& header) {
+    if (!file.isOpen() || file.size() < sizeof(ClipFileHeader)) return false;
+    std::memcpy(&header, file.data(), sizeof(header));
+    std::size_t tableEnd = sizeof(header) + (std::size_t)header.chunkCount * sizeof(ClipChunkEntry);
+    return std::memcmp(header.magic, ClipMagic, sizeof(ClipMagic)) == 0 &&
+           header.version == CompressedClip::Version && header.chunkCount > 0 &&
+           header.keyCount > 0 && tableEnd <= file.size();
+}
+
+bool readClipChunkEntry(const MappedFile& file, std::size_t chunk, ClipChunkEntry& entry) {
+    std::memcpy(&entry, file.data() + sizeof(ClipFileHeader) + chunk * sizeof(ClipChunkEntry),
+        sizeof(entry));
+    return entry.offset <= file.size() && entry.size <= file.size() - entry.offset;
+}
+
+bool CompressedClip::load(const std::string& path) {
+    *this = CompressedClip();
+    MappedFile file(path);
+    ClipFileHeader header;
+    if (!readClipHeader(file, header)) return false;
+
+    for (std::size_t c = 0; c < header.chunkCount; ++c) {
+        ClipChunkEntry entry;
+        CompressedClip chunk;
+        if (!readClipChunkEntry(file, c, entry) ||
+            !chunk.readChunk(file.data() + entry.offset, entry.size) ||
+            blocks.size() + chunk.blocks.size() > 0x10000) {
+            *this = CompressedClip();
+            return false;
+        }
+        append(chunk);
+    }
+    if (packed.size() != header.keyCount) { *this = CompressedClip(); return false; }
+    return true;
+}
+
+// -------------------- Recording --------------------
+
+std::vector<Keyframe> resampleTrack(const AnimationTrack& track, float sampleRate) {
+    std::vector<Keyframe> keys;
+    if (track.empty() || sampleRate <= 0.0f) return keys;
+
+    std::size_t count = (std::size_t)(track.duration() * sampleRate) + 1;
+    keys.reserve(count + 1);
+    for (std::size_t i = 0; i <= count; ++i) {
+        float time = std::min(track.startTime() + (float)i / sampleRate, track.endTime());
+        std::size_t seg = track.findSegment(time);
+        float t = track.localTime(seg, time);
+
+        glm::vec3 tangent = track.sampleTangent(seg, t);
+        glm::vec3 forward = glm::length(tangent) > 1e-6f ? glm::normalize(tangent) : glm::vec3(0, 0, -1);
+        keys.push_back({ track.samplePosition(seg, t), lookRotation(forward), time });
+        if (time >= track.endTime()) break;
+    }
+    return keys;
+}
+
+std::vector<Keyframe> resamplePath(const ArcLengthTable& path, float sampleRate) {
+    std::vector<Keyframe> keys;
+    if (path.empty() || sampleRate <= 0.0f) return keys;
+
+    const float duration = path.track()->duration();
+    std::size_t count = (std::size_t)(duration * sampleRate) + 1;
+    keys.reserve(count + 1);
+    for (std::size_t i = 0; i <= count; ++i) {
+        float time = std::min((float)i / sampleRate, duration);
+        // The table wraps the end of the lap back to its start
+        PathSample sample = path.sample(path.length() * time / duration);
+        keys.push_back({ sample.position, sample.rotation, time });
+        if (time >= duration) break;
+    }
+    return keys;
+}
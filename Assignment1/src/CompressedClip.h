@@ -0,0 +1,130 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include "AnimationTrack.h"
+#include "ArcLengthTable.h"
+#include "FileUtils.h"
+
+// Error bounds for key reduction, measured at every input key and
+// including quantisation error
+struct ClipCompressionSettings {
+    float positionError = 0.01f; // world units
+    float rotationError = 0.1f;  // degrees
+};
+
+// 12-byte key. Position is range-normalised to 16 bits per axis over its
+// block's bounds; rotation is smallest-three: the largest component is
+// dropped (and made positive), the other three are stored in 15 bits each
+// and the dropped index goes in the top bits of the first two words.
+struct PackedKey {
+    std::uint16_t position[3];
+    std::uint16_t rotation[3];
+};
+
+// Quantisation range for a run of keys. Runs are cut so that 16 bits over
+// the run's extent stay well inside the position error bound.
+struct ClipBlock {
+    glm::vec3 rangeMin = glm::vec3(0.0f);
+    glm::vec3 rangeScale = glm::vec3(0.0f); // extent / 65535
+};
+
+// .rclip layout: header, chunk table, then the chunks. A chunk is a
+// run of ChunkKeys key pairs stored as a clip of its own (key count,
+// block count, blocks, times, packed keys, key block indices); it repeats
+// the first key of the next chunk, so any time can be sampled from one
+// chunk and a player only ever needs the chunks around its cursor.
+struct ClipFileHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t keyCount;
+    std::uint32_t chunkCount;
+    std::uint32_t chunkKeys;
+    float startTime;
+    float endTime;
+};
+
+struct ClipChunkEntry {
+    float startTime; // first and last key of the chunk
+    float endTime;
+    std::uint64_t offset; // from the start of the file
+    std::uint32_t size;
+    std::uint32_t keyCount;
+};
+
+// Checks the magic, version and chunk table size of a mapped .rclip
+bool readClipHeader(const MappedFile& file, ClipFileHeader& header);
+// Table entry of chunk; false if its bytes run past the end of the file
+bool readClipChunkEntry(const MappedFile& file, std::size_t chunk, ClipChunkEntry& entry);
+
+// Compressed, linearly interpolated animation clip for long recorded
+// paths. Keys that lerp (position) / nlerp (rotation) between their
+// neighbours within the error bounds are dropped, the rest are quantised.
+class CompressedClip {
+public:
+    static constexpr std::uint32_t Version = 2;
+    static constexpr std::size_t ChunkKeys = 256;
+
+    CompressedClip() = default;
+    // keys are time-ordered samples (all of them are used, unlike
+    // AnimationTrack, which treats the ends as control points)
+    CompressedClip(const std::vector<Keyframe>& keys, const ClipCompressionSettings& settings = {});
+
+    bool empty() const { return packed.size() < 2; }
+    std::size_t keyCount() const { return packed.size(); }
+    float startTime() const { return times.empty() ? 0.0f : times.front(); }
+    float endTime() const { return times.empty() ? 0.0f : times.back(); }
+    float duration() const { return endTime() - startTime(); }
+    std::size_t blockCount() const { return blocks.size(); }
+    // Key data in memory (times, packed keys, block indices and ranges)
+    std::size_t byteSize() const;
+
+    Keyframe key(std::size_t i) const;
+
+    // Interpolated pose at time, clamped to the clip. cursor is the key
+    // pair used last time; forward playback moves it at most one step.
+    void sample(float time, std::size_t& cursor, glm::vec3& position, glm::quat& rotation) const;
+
+    // Keys first..last (inclusive) with just the blocks they use
+    CompressedClip slice(std::size_t first, std::size_t last) const;
+
+    bool save(const std::string& path) const;
+    // Reads the whole clip; StreamingClip reads it a chunk at a time
+    bool load(const std::string& path);
+
+private:
+    friend class StreamingClip;
+
+    void writeChunk(std::vector<unsigned char>& bytes) const;
+    bool readChunk(const unsigned char* data, std::size_t size);
+    // Appends next, which starts with a copy of this clip's last key
+    void append(const CompressedClip& next);
+
+    glm::vec3 decodePosition(std::size_t i) const;
+    static glm::quat decodeRotation(const PackedKey& key);
+    static PackedKey encode(const ClipBlock& block, const glm::vec3& position, const glm::quat& rotation);
+    void locate(float time, std::size_t& cursor) const;
+
+    std::vector<float> times;
+    std::vector<PackedKey> packed;
+    std::vector<std::uint16_t> keyBlock; // block of each key
+    std::vector<ClipBlock> blocks;
+};
+
+// Records a track as evenly spaced keys, rotation facing along the path
+// (as the aircraft flies it), for compression
+std::vector<Keyframe> resampleTrack(const AnimationTrack& track, float sampleRate);
+
+// Records one lap of an arc-length path at constant speed over its track's
+// duration, as updateAircraftFromKeyframes flies it
+std::vector<Keyframe> resamplePath(const ArcLengthTable& path, float sampleRate);
@@ -0,0 +1,171 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#include "CubemapCache.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+namespace {
+
+struct CubeCacheHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t faceSize;
+    std::uint32_t levels;
+    std::uint32_t internalFormat; // format the converter allocated
+    std::uint64_t sourceSize;
+    std::uint64_t sourceHash;
+};
+
+const char CacheMagic[8] = { 'R', 'T', 'A', 'C', 'U', 'B', 'E', '\0' };
+const std::uint32_t CacheVersion = 1;
+const std::size_t BytesPerTexel = 3 * sizeof(std::uint16_t); // RGB half
+
+bool hashSource(const std::string& sourcePath, std::uint64_t& size, std::uint64_t& hash) {
+    MappedFile source(sourcePath);
+    if (!source.isOpen()) return false;
+    size = source.size();
+    hash = hashBytes(source.data(), source.size());
+    return true;
+}
+
+std::size_t levelBytes(int faceSize, int level) {
+    std::size_t dim = (std::size_t)std::max(faceSize >> level, 1);
+    return dim * dim * BytesPerTexel;
+}
+
+} // namespace
+
+std::string CubemapCache::cachePath(const std::string& sourcePath, int faceSize) {
+    return sourcePath + "." + std::to_string(faceSize) + ".cubecache";
+}
+
+bool CubemapCache::read(const std::string& sourcePath, int faceSize, CubemapCacheData& data) {
+    std::uint64_t sourceSize = 0, sourceHash = 0;
+    if (!hashSource(sourcePath, sourceSize, sourceHash)) return false;
+
+    MappedFile file(cachePath(sourcePath, faceSize));
+    CubeCacheHeader header;
+    if (!file.isOpen() || file.size() < sizeof(header)) return false;
+    std::memcpy(&header, file.data(), sizeof(header));
+
+    std::size_t expected = sizeof(header);
+    for (std::uint32_t level = 0; level < header.levels; ++level)
+        expected += 6 * levelBytes(faceSize, (int)level);
+
+    bool valid = std::memcmp(header.magic, CacheMagic, sizeof(CacheMagic)) == 0 &&
+        header.version == CacheVersion &&
+        header.faceSize == (std::uint32_t)faceSize &&
+        header.sourceSize == sourceSize &&
+        header.sourceHash == sourceHash &&
+        header.levels > 0 && file.size() >= expected;
+    if (!valid) return false;
+
+    data.file = std::move(file);
+    data.faceSize = faceSize;
+    data.levels = (int)header.levels;
+    data.internalFormat = (GLint)header.internalFormat;
+    return true;
+}
+
+bool CubemapCache::uploadLevel(const CubemapCacheData& data, GLuint cubemap, int level) {
+    glBindTexture(GL_TEXTURE_CUBE_MAP, cubemap);
+
+    // The engine may have allocated the cubemap either way. Immutable
+    // storage only takes glTexSubImage2D, into levels of the right size it
+    // already has; mutable storage is (re)allocated level by level.
+    GLint immutable = GL_FALSE, immutableLevels = 0, width = 0;
+    if (GLAD_GL_VERSION_4_2 || GLAD_GL_ARB_texture_storage) {
+        glGetTexParameteriv(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_IMMUTABLE_FORMAT, &immutable);
+        glGetTexParameteriv(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_IMMUTABLE_LEVELS, &immutableLevels);
+    }
+    GLsizei dim = std::max(data.faceSize >> level, 1);
+    glGetTexLevelParameteriv(GL_TEXTURE_CUBE_MAP_POSITIVE_X, level, GL_TEXTURE_WIDTH, &width);
+    if (immutable && (immutableLevels < data.levels || width != dim)) {
+        glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+        return false;
+    }
+
+    // Upload straight from the mapping
+    const unsigned char* texels = data.file.data() + sizeof(CubeCacheHeader);
+    for (int previous = 0; previous < level; ++previous)
+        texels += 6 * levelBytes(data.faceSize, previous);
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    for (GLenum face = 0; face < 6; ++face) {
+        if (width == dim)
+            glTexSubImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, level, 0, 0, dim, dim,
+                GL_RGB, GL_HALF_FLOAT, texels);
+        else
+            glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, level, data.internalFormat,
+                dim, dim, 0, GL_RGB, GL_HALF_FLOAT, texels);
+        texels += levelBytes(data.faceSize, level);
+    }
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAX_LEVEL, data.levels - 1);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+    return true;
+}
+
+bool CubemapCache::save(const std::string& sourcePath, GLuint cubemap, int faceSize) {
+    std::uint64_t sourceSize = 0, sourceHash = 0;
+    if (!hashSource(sourcePath, sourceSize, sourceHash)) return false;
+
+    glBindTexture(GL_TEXTURE_CUBE_MAP, cubemap);
+
+    // Count the levels the converter actually allocated
+    GLint internalFormat = 0;
+    glGetTexLevelParameteriv(GL_TEXTURE_CUBE_MAP_POSITIVE_X, 0, GL_TEXTURE_INTERNAL_FORMAT, &internalFormat);
+    std::uint32_t levels = 0;
+    for (int level = 0; (faceSize >> level) > 0; ++level) {
+        GLint width = 0;
+        glGetTexLevelParameteriv(GL_TEXTURE_CUBE_MAP_POSITIVE_X, level, GL_TEXTURE_WIDTH, &width);
+        if (width == 0) break;
+        ++levels;
+    }
+    if (levels == 0) { glBindTexture(GL_TEXTURE_CUBE_MAP, 0); return false; }
+
+    CubeCacheHeader header = {};
+    std::memcpy(header.magic, CacheMagic, sizeof(CacheMagic));
+    header.version = CacheVersion;
+    header.faceSize = (std::uint32_t)faceSize;
+    header.levels = levels;
+    header.internalFormat = (std::uint32_t)internalFormat;
+    header.sourceSize = sourceSize;
+    header.sourceHash = sourceHash;
+
+    std::size_t total = sizeof(header);
+    for (std::uint32_t level = 0; level < levels; ++level)
+        total += 6 * levelBytes(faceSize, (int)level);
+
+    std::vector<unsigned char> bytes(total);
+    std::memcpy(bytes.data(), &header, sizeof(header));
+
+    // Let the driver convert to half floats on the way back
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    unsigned char* texels = bytes.data() + sizeof(header);
+    for (std::uint32_t level = 0; level < levels; ++level) {
+        for (GLenum face = 0; face < 6; ++face) {
+            glGetTexImage(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, (GLint)level,
+                GL_RGB, GL_HALF_FLOAT, texels);
+            texels += levelBytes(faceSize, (int)level);
+        }
+    }
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+
+    std::string path = cachePath(sourcePath, faceSize);
+    if (!writeFileAtomic(path, bytes.data(), bytes.size())) {
+        std::cerr << "[Skybox] Could not write " << path << std::endl;
+        return false;
+    }
+    return true;
+}
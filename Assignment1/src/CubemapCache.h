@@ -0,0 +1,38 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#pragma once
+
+#include <string>
+#include <glad/glad.h>
+
+#include "FileUtils.h"
+
+// A validated cache file, mapped and ready to upload
+struct CubemapCacheData {
+    MappedFile file;
+    int faceSize = 0;
+    int levels = 0;
+    GLint internalFormat = 0;
+};
+
+// Persistent cache for HDRConverter output. Every face and mip level of the
+// converted cubemap is stored as half-float RGB in
+// <source>.<faceSize>.cubecache, keyed by the source content hash and face
+// size, so warm starts skip both the HDR decode and the conversion pass.
+namespace CubemapCache {
+    std::string cachePath(const std::string& sourcePath, int faceSize);
+
+    // Maps and checks the cache; no GL calls, so safe on a worker. False
+    // if missing or stale.
+    bool read(const std::string& sourcePath, int faceSize, CubemapCacheData& data);
+    // Uploads one mip level of all six faces into cubemap's own storage.
+    // False, with nothing uploaded, if that storage cannot take the cache:
+    // immutable (glTexStorage2D) with another face size or fewer levels.
+    bool uploadLevel(const CubemapCacheData& data, GLuint cubemap, int level);
+    // Reads the converted faces back from the GPU and writes the cache
+    bool save(const std::string& sourcePath, GLuint cubemap, int faceSize);
+}
@@ -0,0 +1,60 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Read-only memory mapping of a whole file (mmap / MapViewOfFile)
+class MappedFile {
+public:
+    MappedFile() = default;
+    explicit MappedFile(const std::string& path) { open(path); }
+    ~MappedFile() { close(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    bool open(const std::string& path);
+    void close();
+
+    bool isOpen() const { return bytes != nullptr; }
+    const unsigned char* data() const { return bytes; }
+    std::size_t size() const { return length; }
+
+    // Drops the pages covering [offset, offset + size) from the resident
+    // set; touching them again reads them back from the file
+    void discard(std::size_t offset, std::size_t size) const;
+
+private:
+    const unsigned char* bytes = nullptr;
+    std::size_t length = 0;
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#endif
+};
+
+// 64-bit FNV-1a, chainable through seed
+std::uint64_t hashBytes(const void* data, std::size_t size,
+    std::uint64_t seed = 14695981039346656037ull);
+
+// Size of a file in bytes, or -1 if it cannot be read
+long long fileSize(const std::string& path);
+
+// Last modification time of a file (seconds since the epoch), or -1
+long long fileModifiedTime(const std::string& path);
+
+// Creates a directory (one level); true if it exists afterwards
+bool makeDirectory(const std::string& path);
+
+// Writes to a temporary file first, then renames over path, so readers
+// never observe a half-written cache
+bool writeFileAtomic(const std::string& path, const void* data, std::size_t size);
@@ -0,0 +1,32 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#include "FixedStepClock.h"
+
+#include <algorithm>
+
+FixedStepClock::FixedStepClock(float step, int maxSteps)
+    : stepSize(step), maxSteps(maxSteps) {}
+
+int FixedStepClock::advance(float frameDt) {
+    accumulator += std::max(frameDt, 0.0f);
+
+    int steps = (int)(accumulator / stepSize);
+    if (steps > maxSteps) {
+        steps = maxSteps;
+        accumulator = 0.0f;
+        return steps;
+    }
+    accumulator -= steps * stepSize;
+    return steps;
+}
+
+void FixedStepClock::setStep(float step) {
+    // Keep the fraction so a rate change does not pop the interpolation
+    float fraction = alpha();
+    stepSize = step;
+    accumulator = fraction * stepSize;
+}
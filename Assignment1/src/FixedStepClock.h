@@ -0,0 +1,32 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#pragma once
+
+// Accumulator for a fixed-timestep simulation: feed it the real frame
+// delta, run the returned number of steps, then render with alpha() as
+// the blend between the previous and the current step's state
+class FixedStepClock {
+public:
+    explicit FixedStepClock(float step = 1.0f / 120.0f, int maxSteps = 8);
+
+    // Steps owed for this frame; a long hitch is capped at maxSteps and
+    // the rest of the time dropped, so the sim slows down instead of
+    // spiralling
+    int advance(float frameDt);
+
+    // Leftover time as a fraction of a step, in [0, 1)
+    float alpha() const { return accumulator / stepSize; }
+    float step() const { return stepSize; }
+
+    void setStep(float step);
+    void reset() { accumulator = 0.0f; }
+
+private:
+    float stepSize;
+    int maxSteps;
+    float accumulator = 0.0f;
+};
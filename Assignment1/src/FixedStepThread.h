@@ -0,0 +1,127 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <thread>
+
+#include "FixedStepClock.h"
+#include "TripleBuffer.h"
+
+// Runs a fixed-step simulation on its own thread. Controls go in and
+// state snapshots come out through triple buffers, so the render thread
+// never blocks on the simulation or the other way round.
+template <typename State, typename Controls>
+class FixedStepThread {
+public:
+    using StepFn = std::function<void(State& state, const Controls& controls, float dt)>;
+
+    // The last two steps, stamped with when the current one finished
+    struct Frame {
+        State previous;
+        State current;
+        double time = 0.0;
+    };
+
+    ~FixedStepThread() { stop(); }
+
+    void start(const State& initial, const Controls& controls, StepFn step, float stepSize) {
+        stop();
+        stepFn = std::move(step);
+        clock = FixedStepClock(stepSize);
+        setControls(controls);
+
+        latestFrame = Frame{ initial, initial, now() };
+        Frame& first = frames.back();
+        first = latestFrame;
+        frames.publish();
+
+        // The worker gets its own copy of the start state; latestFrame is
+        // only ever touched by the reader
+        running = true;
+        worker = std::thread([this, initial] { run(initial); });
+    }
+
+    // Joins the thread; returns the final state so a caller can carry on
+    // stepping it on the main thread
+    State stop() {
+        if (running.exchange(false) && worker.joinable()) worker.join();
+        poll();
+        return latestFrame.current;
+    }
+
+    bool isRunning() const { return running; }
+
+    void setControls(const Controls& controls) {
+        controlsBuffer.back() = controls;
+        controlsBuffer.publish();
+    }
+
+    // Newest published frame (unchanged if nothing new)
+    const Frame& poll() {
+        if (frames.update()) latestFrame = frames.front();
+        return latestFrame;
+    }
+
+    // Blend factor for drawing frame at the current time: the renderer
+    // runs one step behind the simulation so it always has two states
+    // to interpolate between
+    float alpha(const Frame& frame) const {
+        float t = (float)((now() - frame.time) / clock.step());
+        return std::min(std::max(t, 0.0f), 1.0f);
+    }
+
+    static double now() {
+        using namespace std::chrono;
+        return duration<double>(steady_clock::now().time_since_epoch()).count();
+    }
+
+private:
+    void run(const State& initial) {
+        State previous = initial;
+        State current = initial;
+        double last = now();
+
+        while (running) {
+            double t = now();
+            int steps = clock.advance((float)(t - last));
+            last = t;
+
+            controlsBuffer.update();
+            const Controls& controls = controlsBuffer.front();
+            for (int i = 0; i < steps; ++i) {
+                previous = current;
+                stepFn(current, controls, clock.step());
+            }
+
+            if (steps > 0) {
+                Frame& out = frames.back();
+                out.previous = previous;
+                out.current = current;
+                // current is the state at t minus the time still owed
+                out.time = t - clock.alpha() * clock.step();
+                frames.publish();
+            }
+
+            // Sleep off the rest of the step
+            double wait = (1.0 - clock.alpha()) * clock.step();
+            std::this_thread::sleep_for(std::chrono::duration<double>(wait));
+        }
+    }
+
+    StepFn stepFn;
+    FixedStepClock clock;
+    std::atomic<bool> running{ false };
+    std::thread worker;
+
+    TripleBuffer<Controls> controlsBuffer;
+    TripleBuffer<Frame> frames;
+    Frame latestFrame;   // reader side only
+};
@@ -0,0 +1,38 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#include "FrameUniforms.h"
+
+#include <cstring>
+
+void FrameUniforms::create() {
+    glGenBuffers(1, &ubo);
+    glBindBuffer(GL_UNIFORM_BUFFER, ubo);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(FrameUniformData), nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    glBindBufferBase(GL_UNIFORM_BUFFER, Binding, ubo);
+}
+
+void FrameUniforms::update(const FrameUniformData& data, StreamBuffer* stream) {
+    StreamAllocation slot;
+    if (stream) slot = stream->allocate(sizeof(FrameUniformData), stream->alignmentFor(GL_UNIFORM_BUFFER));
+    if (slot) {
+        std::memcpy(slot.data, &data, sizeof(FrameUniformData));
+        stream->commit(slot);
+        glBindBufferRange(GL_UNIFORM_BUFFER, Binding, slot.buffer, slot.offset, sizeof(FrameUniformData));
+        return;
+    }
+
+    glBindBuffer(GL_UNIFORM_BUFFER, ubo);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(FrameUniformData), &data);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    glBindBufferBase(GL_UNIFORM_BUFFER, Binding, ubo);
+}
+
+void FrameUniforms::Delete() {
+    if (ubo) glDeleteBuffers(1, &ubo);
+    ubo = 0;
+}
@@ -0,0 +1,41 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#pragma once
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include "StreamBuffer.h"
+
+// Mirrors the std140 "FrameData" block declared in the shaders
+struct FrameUniformData {
+    glm::mat4 camMatrix;  // proj * view
+    glm::vec4 camPos;     // xyz
+    glm::vec4 lightColor; // rgb pre-multiplied by intensity
+    glm::vec4 lightDir;   // xyz
+    float ambient;
+    float skyboxExposure;
+    float pad[2];
+};
+static_assert(sizeof(FrameUniformData) == 128, "FrameUniformData must match std140 layout");
+
+// Camera and light state, uploaded once per frame into a uniform buffer
+// bound at a fixed binding point that every scene program reads from
+class FrameUniforms {
+public:
+    static constexpr GLuint Binding = 0;
+    static constexpr const char* BlockName = "FrameData";
+
+    void create();
+    // Into the stream buffer when given one with room, binding the block
+    // to that range; else into the block's own buffer
+    void update(const FrameUniformData& data, StreamBuffer* stream = nullptr);
+    void Delete();
+
+private:
+    GLuint ubo = 0;
+};
@@ -0,0 +1,48 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#include "GlState.h"
+
+void GlState::useProgram(GLuint name) {
+    tally.programs.submitted++;
+    if (name == program) return;
+    glUseProgram(name);
+    program = name;
+    tally.programs.issued++;
+}
+
+void GlState::bindVertexArray(GLuint name) {
+    tally.vertexArrays.submitted++;
+    if (name == vao) return;
+    glBindVertexArray(name);
+    vao = name;
+    tally.vertexArrays.issued++;
+}
+
+void GlState::bindTexture(GLuint unit, GLenum target, GLuint texture) {
+    tally.textures.submitted++;
+    if (unit < MaxUnits && textures[unit] == texture && targets[unit] == target) return;
+    if (unit != activeUnit) {
+        glActiveTexture(GL_TEXTURE0 + unit);
+        activeUnit = unit;
+    }
+    glBindTexture(target, texture);
+    if (unit < MaxUnits) {
+        textures[unit] = texture;
+        targets[unit] = target;
+    }
+    tally.textures.issued++;
+}
+
+void GlState::invalidate() {
+    program = Unknown;
+    vao = Unknown;
+    activeUnit = Unknown;
+    for (GLuint unit = 0; unit < MaxUnits; ++unit) {
+        textures[unit] = Unknown;
+        targets[unit] = 0;
+    }
+}
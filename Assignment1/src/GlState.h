@@ -0,0 +1,51 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#pragma once
+
+#include <glad/glad.h>
+
+// Bind calls asked for versus the ones that reached GL
+struct StateCount {
+    int submitted = 0;
+    int issued = 0;
+};
+
+// Shadow copy of the bindings the render queue changes; calls that would
+// not change anything are dropped. It only sees changes made through it,
+// so invalidate() after any other code may have bound something.
+class GlState {
+public:
+    static constexpr GLuint MaxUnits = 16;
+
+    struct Counts {
+        StateCount programs;
+        StateCount textures;
+        StateCount vertexArrays;
+    };
+
+    GlState() { invalidate(); }
+
+    void useProgram(GLuint program);
+    void bindVertexArray(GLuint vao);
+    void bindTexture(GLuint unit, GLenum target, GLuint texture);
+
+    // Forgets every binding, so the next call of each kind goes through
+    void invalidate();
+
+    const Counts& counts() const { return tally; }
+    void resetCounts() { tally = Counts(); }
+
+private:
+    static constexpr GLuint Unknown = ~0u;
+
+    GLuint program;
+    GLuint vao;
+    GLuint activeUnit;
+    GLuint textures[MaxUnits];
+    GLenum targets[MaxUnits];
+    Counts tally;
+};
@@ -0,0 +1,42 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#include "GpuTimer.h"
+
+void GpuTimer::create() {
+    glGenQueries(2, queries);
+}
+
+void GpuTimer::begin() {
+    glBeginQuery(GL_TIME_ELAPSED, queries[current]);
+}
+
+void GpuTimer::end() {
+    glEndQuery(GL_TIME_ELAPSED);
+    issued[current] = true;
+    current ^= 1;
+}
+
+bool GpuTimer::latestMs(float& ms) {
+    // The slot we will write next holds the previous frame's query
+    int slot = current;
+    if (!issued[slot]) return false;
+
+    GLint available = 0;
+    glGetQueryObjectiv(queries[slot], GL_QUERY_RESULT_AVAILABLE, &available);
+    if (!available) return false;
+
+    GLuint64 ns = 0;
+    glGetQueryObjectui64v(queries[slot], GL_QUERY_RESULT, &ns);
+    issued[slot] = false;
+    ms = (float)((double)ns / 1.0e6);
+    return true;
+}
+
+void GpuTimer::Delete() {
+    if (queries[0]) glDeleteQueries(2, queries);
+    queries[0] = queries[1] = 0;
+}
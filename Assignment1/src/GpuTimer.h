@@ -0,0 +1,27 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#pragma once
+
+#include <glad/glad.h>
+
+// GL_TIME_ELAPSED query pair used round-robin: each frame reads the result
+// of the query issued the frame before, so it never waits on the GPU.
+// Queries of this target cannot nest.
+class GpuTimer {
+public:
+    void create();
+    void begin();
+    void end();
+    // Most recent finished measurement; false until one is available
+    bool latestMs(float& ms);
+    void Delete();
+
+private:
+    GLuint queries[2] = { 0, 0 };
+    bool issued[2] = { false, false };
+    int current = 0;
+};
@@ -0,0 +1,16 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#include "ImageDecode.h"
+
+#include <stb/stb_image.h>
+
+unsigned char* decodeImageRgba(const std::string& path, int& width, int& height) {
+    // Thread-local, overrides the global flag on this thread only
+    stbi_set_flip_vertically_on_load_thread(1);
+    int channels = 0;
+    return stbi_load(path.c_str(), &width, &height, &channels, 4);
+}
@@ -0,0 +1,15 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#pragma once
+
+#include <string>
+
+// stb_image load to RGBA8, bottom row first to match the GL texture origin.
+// Safe from any thread: the flip is set for the calling thread only, so it
+// neither races nor changes the engine's own (global) setting. Free the
+// result with stbi_image_free; null on failure (stbi_failure_reason says why).
+unsigned char* decodeImageRgba(const std::string& path, int& width, int& height);
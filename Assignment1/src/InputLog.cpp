@@ -0,0 +1,179 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#include "InputLog.h"
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+namespace {
+
+struct InputLogHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t paramsSize;
+    std::uint32_t frameCount; // written on close
+};
+
+const char LogMagic[8] = { 'R', 'T', 'A', 'I', 'N', 'P', 'U', 'T' };
+const std::uint32_t LogVersion = 1;
+
+enum FrameFlags : std::uint8_t {
+    CinemaToggle = 1,
+    CameraMoved = 2,
+    ParamsChanged = 4
+};
+
+const std::size_t FrameBytes = 1 + sizeof(float) + 3;
+const std::size_t CameraBytes = 6 * sizeof(float);
+
+} // namespace
+
+// -------------------- Options --------------------
+
+InputLogOptions parseInputLogOptions(int argc, char** argv) {
+    InputLogOptions options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (arg == "--record" && hasValue) options.recordPath = argv[++i];
+        else if (arg == "--replay" && hasValue) options.replayPath = argv[++i];
+        else if (arg == "--replay-dt" && hasValue) options.fixedDt = (float)std::atof(argv[++i]);
+        else if (arg == "--replay-out" && hasValue) options.outPath = argv[++i];
+    }
+    if (!(options.fixedDt > 0.0f)) options.fixedDt = 0.0f;
+    return options;
+}
+
+// -------------------- Recorder --------------------
+
+bool InputRecorder::open(const std::string& path, std::size_t paramsSize) {
+    out.open(path, std::ios::binary | std::ios::trunc);
+    if (!out) return false;
+
+    InputLogHeader header = {};
+    std::memcpy(header.magic, LogMagic, sizeof(LogMagic));
+    header.version = LogVersion;
+    header.paramsSize = (std::uint32_t)paramsSize;
+    out.write((const char*)&header, sizeof(header));
+    paramsBytes = paramsSize;
+    count = 0;
+    bytes = sizeof(header);
+    return (bool)out;
+}
+
+void InputRecorder::write(const InputFrame& frame, const void* params, bool paramsChanged) {
+    if (!out.is_open()) return;
+
+    std::uint8_t flags = 0;
+    if (frame.cinemaToggle) flags |= CinemaToggle;
+    if (count == 0 || frame.cameraPosition != last.cameraPosition ||
+        frame.cameraOrientation != last.cameraOrientation)
+        flags |= CameraMoved;
+    if (count == 0 || paramsChanged) flags |= ParamsChanged;
+
+    unsigned char record[FrameBytes + CameraBytes];
+    record[0] = flags;
+    std::memcpy(record + 1, &frame.dt, sizeof(float));
+    std::memcpy(record + 1 + sizeof(float), frame.axes, 3);
+    std::size_t size = FrameBytes;
+    if (flags & CameraMoved) {
+        std::memcpy(record + size, &frame.cameraPosition, 3 * sizeof(float));
+        std::memcpy(record + size + 3 * sizeof(float), &frame.cameraOrientation, 3 * sizeof(float));
+        size += CameraBytes;
+    }
+    out.write((const char*)record, (std::streamsize)size);
+    if (flags & ParamsChanged) {
+        out.write((const char*)params, (std::streamsize)paramsBytes);
+        size += paramsBytes;
+    }
+
+    last = frame;
+    count++;
+    bytes += size;
+}
+
+bool InputRecorder::close() {
+    if (!out.is_open()) return false;
+    std::uint32_t frameCount = (std::uint32_t)count;
+    out.seekp(offsetof(InputLogHeader, frameCount));
+    out.write((const char*)&frameCount, sizeof(frameCount));
+    bool ok = (bool)out;
+    out.close();
+    return ok;
+}
+
+// -------------------- Player --------------------
+
+bool InputPlayer::open(const std::string& path, std::size_t paramsSize) {
+    if (!file.open(path)) return false;
+
+    InputLogHeader header;
+    bool valid = file.size() >= sizeof(header);
+    if (valid) {
+        std::memcpy(&header, file.data(), sizeof(header));
+        valid = std::memcmp(header.magic, LogMagic, sizeof(LogMagic)) == 0 &&
+            header.version == LogVersion;
+    }
+    if (!valid) {
+        std::cerr << "[Replay] " << path << " is not an input log" << std::endl;
+        file.close();
+        return false;
+    }
+    if (header.paramsSize != paramsSize) {
+        std::cerr << "[Replay] " << path << " was recorded by a build with different parameters" << std::endl;
+        file.close();
+        return false;
+    }
+
+    paramsBytes = paramsSize;
+    cursor = sizeof(header);
+    count = (int)header.frameCount;
+    index = 0;
+    // Never closed (the recording app was killed): play what made it out
+    if (count == 0) {
+        for (std::size_t at = cursor; at + FrameBytes <= file.size(); ++count) {
+            std::uint8_t flags = file.data()[at];
+            at += FrameBytes + ((flags & CameraMoved) ? CameraBytes : 0) +
+                ((flags & ParamsChanged) ? paramsBytes : 0);
+            if (at > file.size()) break;
+        }
+    }
+    return true;
+}
+
+bool InputPlayer::next(InputFrame& frame) {
+    frameParams = nullptr;
+    if (done()) return false;
+
+    // A truncated log ends where its data does
+    const unsigned char* data = file.data();
+    if (cursor + FrameBytes > file.size()) { count = index; return false; }
+    std::uint8_t flags = data[cursor];
+    std::size_t size = FrameBytes + ((flags & CameraMoved) ? CameraBytes : 0) +
+        ((flags & ParamsChanged) ? paramsBytes : 0);
+    if (cursor + size > file.size()) { count = index; return false; }
+
+    frame = last;
+    frame.cinemaToggle = (flags & CinemaToggle) != 0;
+    std::memcpy(&frame.dt, data + cursor + 1, sizeof(float));
+    std::memcpy(frame.axes, data + cursor + 1 + sizeof(float), 3);
+    std::size_t offset = cursor + FrameBytes;
+    if (flags & CameraMoved) {
+        std::memcpy(&frame.cameraPosition, data + offset, 3 * sizeof(float));
+        std::memcpy(&frame.cameraOrientation, data + offset + 3 * sizeof(float), 3 * sizeof(float));
+        offset += CameraBytes;
+    }
+    if (flags & ParamsChanged) frameParams = data + offset;
+
+    last = frame;
+    cursor += size;
+    index++;
+    return true;
+}
@@ -0,0 +1,94 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "FileUtils.h"
+
+// Record a session's input, then play it back so two builds run exactly
+// the same workload:
+//
+//   app --record session.rinput
+//   app --replay session.rinput [--replay-dt S] [--replay-out profile.csv]
+//
+// A replay runs every recorded frame with its dt (or a fixed one), then
+// writes the profiler's per-frame timings for the whole run and exits.
+struct InputLogOptions {
+    std::string recordPath;
+    std::string replayPath;
+    std::string outPath = "replay.csv";
+    float fixedDt = 0.0f; // 0 replays the recorded dt stream
+};
+
+InputLogOptions parseInputLogOptions(int argc, char** argv);
+
+// Everything that drove one frame
+struct InputFrame {
+    float dt = 0.0f;
+    std::int8_t axes[3] = {};  // aircraft pitch, yaw, roll: -1, 0 or +1
+    bool cinemaToggle = false; // 'P' pressed this frame
+    glm::vec3 cameraPosition = glm::vec3(0.0f);
+    glm::vec3 cameraOrientation = glm::vec3(0.0f);
+};
+
+// Writes frames to <path> as they happen. A frame is a flag byte, dt and
+// the three axes (8 bytes); the camera pose follows only when it moved,
+// the GUI parameter block only when it was edited.
+class InputRecorder {
+public:
+    ~InputRecorder() { close(); }
+
+    // paramsSize is the byte size of the parameter block written with edits
+    bool open(const std::string& path, std::size_t paramsSize);
+    // The parameter block is stored on the first frame and whenever
+    // paramsChanged; the replay copies it back byte for byte
+    void write(const InputFrame& frame, const void* params, bool paramsChanged);
+    // Patches the frame count into the header
+    bool close();
+
+    bool isOpen() const { return out.is_open(); }
+    int frames() const { return count; }
+    std::size_t bytesWritten() const { return bytes; }
+
+private:
+    std::ofstream out;
+    std::size_t paramsBytes = 0;
+    InputFrame last;
+    int count = 0;
+    std::size_t bytes = 0;
+};
+
+// Reads a log written by InputRecorder, one frame per next()
+class InputPlayer {
+public:
+    // False if the file is missing, damaged, or was recorded with a
+    // different parameter block (a build whose TweakableParams changed)
+    bool open(const std::string& path, std::size_t paramsSize);
+
+    // The next recorded frame; false once all have been played
+    bool next(InputFrame& frame);
+    // Parameter block stored with the current frame, or null if unchanged
+    const void* params() const { return frameParams; }
+
+    bool isOpen() const { return file.isOpen(); }
+    bool done() const { return index >= count; }
+    int frames() const { return count; }
+
+private:
+    MappedFile file;
+    std::size_t paramsBytes = 0;
+    std::size_t cursor = 0;
+    int count = 0;
+    int index = 0;
+    InputFrame last;
+    const void* frameParams = nullptr;
+};
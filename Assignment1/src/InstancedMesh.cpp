@@ -0,0 +1,175 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#include "InstancedMesh.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+InstancedMesh::InstancedMesh(const MeshView& mesh) {
+    upload(mesh);
+}
+
+void InstancedMesh::upload(const MeshView& mesh) {
+    if (!vao) {
+        glGenVertexArrays(1, &vao);
+        glGenBuffers(1, &vbo);
+        glGenBuffers(1, &ebo);
+        glGenBuffers(1, &instanceVbo);
+    }
+    glBindVertexArray(vao);
+
+    // Static geometry
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glBufferData(GL_ARRAY_BUFFER, mesh.vertexCount * sizeof(MeshVertex),
+        mesh.vertices, GL_STATIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, mesh.indexBytes(), mesh.indices, GL_STATIC_DRAW);
+    indexSize = mesh.indexSize;
+    indexType = mesh.indexSize == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+    lods.clear();
+    for (std::size_t i = 0; i < mesh.levelCount(); ++i) lods.push_back(mesh.level(i));
+
+    const GLsizei stride = sizeof(MeshVertex);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(MeshVertex, position));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(MeshVertex, normal));
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(MeshVertex, color));
+    glEnableVertexAttribArray(3);
+    glVertexAttribPointer(3, 2, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(MeshVertex, texUV));
+
+    // Per-instance matrices, one column per attribute slot
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVbo);
+    for (GLuint col = 0; col < 4; ++col) {
+        glEnableVertexAttribArray(InstanceAttrib + col);
+        glVertexAttribDivisor(InstanceAttrib + col, 1);
+    }
+    for (GLuint col = 0; col < 3; ++col) {
+        glEnableVertexAttribArray(NormalAttrib + col);
+        glVertexAttribDivisor(NormalAttrib + col, 1);
+    }
+    instanceSource = instanceVbo;
+    instanceBase = 0;
+    bindInstanceAttribs(0);
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+// Points the instance attributes at firstInstance, so each LOD's draw
+// reads its own run of the buffer (no base-instance draws in GL 3.3).
+// Expects the VAO and instanceSource to be bound.
+void InstancedMesh::bindInstanceAttribs(GLsizeiptr firstInstance) const {
+    const GLsizeiptr base = instanceBase + firstInstance * sizeof(InstanceData);
+    for (GLuint col = 0; col < 4; ++col) {
+        glVertexAttribPointer(InstanceAttrib + col, 4, GL_FLOAT, GL_FALSE, sizeof(InstanceData),
+            (void*)(base + offsetof(InstanceData, model) + sizeof(glm::vec4) * col));
+    }
+    for (GLuint col = 0; col < 3; ++col) {
+        glVertexAttribPointer(NormalAttrib + col, 3, GL_FLOAT, GL_FALSE, sizeof(InstanceData),
+            (void*)(base + offsetof(InstanceData, normalMatrix) + sizeof(glm::vec3) * col));
+    }
+}
+
+void InstancedMesh::updateInstances(const std::vector<InstanceData>& instanceData,
+    const std::vector<GLsizei>& levelCounts) {
+    instances = (GLsizei)instanceData.size();
+    instancesPerLevel = levelCounts;
+    if (instancesPerLevel.empty()) instancesPerLevel.push_back(instances);
+    instancesPerLevel.resize(std::min(instancesPerLevel.size(), lods.size()));
+
+    GLsizeiptr bytes = instanceData.size() * sizeof(InstanceData);
+
+    // Written straight to this frame's region of the stream buffer
+    StreamAllocation slot;
+    if (stream) slot = stream->allocate((std::size_t)bytes);
+    if (slot) {
+        std::memcpy(slot.data, instanceData.data(), (std::size_t)bytes);
+        stream->commit(slot);
+        instanceSource = slot.buffer;
+        instanceBase = slot.offset;
+        return;
+    }
+
+    instanceSource = instanceVbo;
+    instanceBase = 0;
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVbo);
+    if (bytes > instanceCapacity) {
+        instanceCapacity = bytes;
+        glBufferData(GL_ARRAY_BUFFER, bytes, instanceData.data(), GL_STREAM_DRAW);
+    } else {
+        // Orphan the old storage so we never wait on last frame's draw
+        glBufferData(GL_ARRAY_BUFFER, instanceCapacity, nullptr, GL_STREAM_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, instanceData.data());
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void InstancedMesh::Draw(const ShaderProgram& shader) {
+    if (!vao || instances == 0) return;
+    shader.Activate();
+    for (std::size_t unit = 0; unit < textures.size(); ++unit) {
+        glActiveTexture(GL_TEXTURE0 + (GLenum)unit);
+        glBindTexture(GL_TEXTURE_2D, textures[unit]);
+    }
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, instanceSource);
+
+    // One instanced draw per LOD that has any instances
+    triangles = 0;
+    draws = 0;
+    GLsizeiptr first = 0;
+    for (std::size_t level = 0; level < instancesPerLevel.size(); ++level) {
+        GLsizei count = instancesPerLevel[level];
+        if (count == 0) continue;
+        const MeshLod& lod = lods[level];
+        bindInstanceAttribs(first);
+        glDrawElementsInstanced(GL_TRIANGLES, (GLsizei)lod.indexCount, indexType,
+            (void*)((GLsizeiptr)lod.indexOffset * indexSize), count);
+        triangles += (long long)(lod.indexCount / 3) * count;
+        draws++;
+        first += count;
+    }
+
+    // Leave the VAO pointing at the first instance
+    if (first > 0) bindInstanceAttribs(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+}
+
+DrawItem InstancedMesh::drawItem(int level, GLsizei firstInstance, GLsizei count) const {
+    const MeshLod& lod = lods[level];
+    DrawItem item;
+    item.vao = vao;
+    item.count = (GLsizei)lod.indexCount;
+    item.indexType = indexType;
+    item.indexOffset = (std::size_t)lod.indexOffset * indexSize;
+    item.instances = count;
+    item.prepare = &InstancedMesh::prepareDraw;
+    item.owner = this;
+    item.arg = (std::uint32_t)firstInstance;
+    return item;
+}
+
+// Runs with the item's VAO bound; points it at the item's instances
+void InstancedMesh::prepareDraw(const void* mesh, std::uint32_t firstInstance) {
+    const InstancedMesh& self = *static_cast<const InstancedMesh*>(mesh);
+    glBindBuffer(GL_ARRAY_BUFFER, self.instanceSource);
+    self.bindInstanceAttribs(firstInstance);
+}
+
+void InstancedMesh::Delete() {
+    if (!vao) return;
+    glDeleteBuffers(1, &instanceVbo);
+    glDeleteBuffers(1, &ebo);
+    glDeleteBuffers(1, &vbo);
+    glDeleteVertexArrays(1, &vao);
+    vao = vbo = ebo = instanceVbo = 0;
+    instanceCapacity = 0;
+}
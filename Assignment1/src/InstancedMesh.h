@@ -0,0 +1,82 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include "MeshData.h"
+#include "RenderQueue.h"
+#include "ShaderProgram.h"
+#include "StreamBuffer.h"
+
+// Per-instance vertex data (attribute locations 4-10)
+struct InstanceData {
+    glm::mat4 model;
+    glm::mat3 normalMatrix;
+};
+
+// GPU copy of a MeshData plus a streamed per-instance transform buffer,
+// drawn with one glDrawElementsInstanced call per frame
+class InstancedMesh {
+public:
+    // First attribute location used by the per-instance model matrix (4 slots)
+    static constexpr GLuint InstanceAttrib = 4;
+    // First attribute location of the per-instance normal matrix (3 slots)
+    static constexpr GLuint NormalAttrib = 8;
+
+    InstancedMesh() = default;
+    explicit InstancedMesh(const MeshView& mesh);
+
+    void upload(const MeshView& mesh);
+    // Replaces the instance buffer contents for this frame. With
+    // levelCounts, instances are grouped by LOD, finest first: the first
+    // levelCounts[0] use LOD 0, the next levelCounts[1] LOD 1, ...
+    void updateInstances(const std::vector<InstanceData>& instanceData,
+        const std::vector<GLsizei>& levelCounts = {});
+    // Instances go through the per-frame stream buffer when it has room
+    void setStream(StreamBuffer* buffer) { stream = buffer; }
+    // Textures bound to units 0..n-1 for every draw
+    void setTextures(const std::vector<GLuint>& units) { textures = units; }
+    void Draw(const ShaderProgram& shader);
+    // Render queue item drawing count instances from firstInstance (of the
+    // last updateInstances) at one LOD. Program and material are left for
+    // the caller.
+    DrawItem drawItem(int level, GLsizei firstInstance, GLsizei count) const;
+    void Delete();
+
+    GLsizei instanceCount() const { return instances; }
+    GLsizei indexCount() const { return lods.empty() ? 0 : (GLsizei)lods[0].indexCount; }
+    int levelCount() const { return (int)lods.size(); }
+    GLsizei levelTriangles(int level) const { return (GLsizei)lods[level].indexCount / 3; }
+    // Triangles and draw calls submitted by the last Draw
+    long long trianglesDrawn() const { return triangles; }
+    int drawCalls() const { return draws; }
+
+private:
+    GLuint vao = 0;
+    GLuint vbo = 0;
+    GLuint ebo = 0;
+    GLuint instanceVbo = 0;
+    StreamBuffer* stream = nullptr;
+    GLuint instanceSource = 0;     // this frame's: instanceVbo or the stream
+    GLintptr instanceBase = 0;     // bytes into instanceSource
+    std::vector<GLuint> textures;
+    void bindInstanceAttribs(GLsizeiptr firstInstance) const;
+    static void prepareDraw(const void* mesh, std::uint32_t firstInstance);
+
+    std::vector<MeshLod> lods;
+    GLuint indexSize = 4;
+    GLenum indexType = GL_UNSIGNED_INT;
+    std::vector<GLsizei> instancesPerLevel;
+    long long triangles = 0;
+    int draws = 0;
+    GLsizei instances = 0;
+    GLsizeiptr instanceCapacity = 0; // bytes
+};
@@ -0,0 +1,39 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#include "LodSelector.h"
+
+#include <algorithm>
+#include <limits>
+
+float projectedDiameter(const glm::mat4& viewProj, const glm::vec3& center,
+    float radius, float viewportHeight) {
+    // glm is column-major: m[col][row]
+    float w = viewProj[0][3] * center.x + viewProj[1][3] * center.y +
+              viewProj[2][3] * center.z + viewProj[3][3];
+    // Touching or behind the eye: treat as filling the screen
+    if (w <= radius) return std::numeric_limits<float>::max();
+
+    float focalY = glm::length(glm::vec3(viewProj[0][1], viewProj[1][1], viewProj[2][1]));
+    // NDC spans 2 units over the viewport height
+    return radius * focalY / w * viewportHeight;
+}
+
+int LodSelector::select(std::size_t instance, float pixels, int levelCount) {
+    if (instance >= current.size()) current.resize(instance + 1, 0);
+    int level = std::min((int)current[instance], levelCount - 1);
+
+    // Finer while comfortably above the threshold of the next finer level
+    while (level > 0 && pixels > thresholds[level - 1] * bias * (1.0f + hysteresis))
+        level--;
+    // Coarser while comfortably below this level's own threshold
+    while (level < levelCount - 1 && level < MaxLevels - 1 &&
+           pixels < thresholds[level] * bias * (1.0f - hysteresis))
+        level++;
+
+    current[instance] = (std::uint8_t)level;
+    return level;
+}
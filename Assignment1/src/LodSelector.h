@@ -0,0 +1,42 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+// Diameter in pixels of a world-space sphere, from the combined
+// projection * view matrix. Row 1 of its upper 3x3 is the view's up axis
+// scaled by the projection's y focal length, and row 3 gives clip w.
+float projectedDiameter(const glm::mat4& viewProj, const glm::vec3& center,
+    float radius, float viewportHeight);
+
+// Per-instance LOD choice from projected size, with hysteresis so an
+// instance hovering at a threshold does not flip every frame
+class LodSelector {
+public:
+    static constexpr int MaxLevels = 4;
+
+    // Smallest projected diameter (pixels) that still uses level i, for
+    // i = 0..MaxLevels-2; anything smaller goes coarser
+    float thresholds[MaxLevels - 1] = { 250.0f, 100.0f, 40.0f };
+    // Fraction a threshold must be crossed by before switching
+    float hysteresis = 0.15f;
+    // Scales every threshold: > 1 switches to coarse levels sooner
+    float bias = 1.0f;
+
+    // Level for the given instance this frame; instances are identified
+    // by index and keep their level between calls
+    int select(std::size_t instance, float pixels, int levelCount);
+
+    void reset() { current.clear(); }
+
+private:
+    std::vector<std::uint8_t> current;
+};
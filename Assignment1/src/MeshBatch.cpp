@@ -0,0 +1,189 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#include "MeshBatch.h"
+
+#include <cstddef>
+#include <cstring>
+
+namespace {
+
+// Orphans the old store so the driver never waits on last frame's reads
+void orphanUpload(GLenum target, GLuint buffer, const void* data, std::size_t bytes) {
+    glBindBuffer(target, buffer);
+    glBufferData(target, (GLsizeiptr)bytes, nullptr, GL_STREAM_DRAW);
+    glBufferSubData(target, 0, (GLsizeiptr)bytes, data);
+}
+
+} // namespace
+
+bool MeshBatch::supported() {
+    return GLAD_GL_VERSION_4_3 != 0;
+}
+
+int MeshBatch::addMesh(const MeshView& mesh) {
+    const GLint baseVertex = (GLint)vertices.size();
+    const GLuint baseIndex = (GLuint)indices.size();
+    vertices.insert(vertices.end(), mesh.vertices, mesh.vertices + mesh.vertexCount);
+    // One index type for everything, so 16-bit meshes widen
+    for (std::size_t i = 0; i < mesh.indexCount; ++i) indices.push_back(mesh.index(i));
+
+    std::vector<Range> levels;
+    for (std::size_t i = 0; i < mesh.levelCount(); ++i) {
+        MeshLod lod = mesh.level(i);
+        levels.push_back({ baseIndex + lod.indexOffset, lod.indexCount, baseVertex });
+    }
+    meshes.push_back(levels);
+    return (int)meshes.size() - 1;
+}
+
+int MeshBatch::addMaterial(int diffuseLayer, int specularLayer) {
+    materials.push_back(glm::uvec2((unsigned)diffuseLayer, (unsigned)specularLayer));
+    return (int)materials.size() - 1;
+}
+
+void MeshBatch::build() {
+    glGenVertexArrays(1, &vao);
+    glGenBuffers(1, &vbo);
+    glGenBuffers(1, &ebo);
+    glGenBuffers(1, &instanceVbo);
+    glGenBuffers(1, &commandBuffer);
+    glGenBuffers(1, &materialBuffer);
+    glBindVertexArray(vao);
+
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(MeshVertex), vertices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(std::uint32_t), indices.data(), GL_STATIC_DRAW);
+
+    // Same vertex layout as InstancedMesh
+    const GLsizei stride = sizeof(MeshVertex);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(MeshVertex, position));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(MeshVertex, normal));
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(MeshVertex, color));
+    glEnableVertexAttribArray(3);
+    glVertexAttribPointer(3, 2, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(MeshVertex, texUV));
+
+    // Instances are fetched from each command's base instance; the
+    // pointers only move when the instances land somewhere else
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVbo);
+    for (GLuint col = 0; col < 4; ++col) {
+        glEnableVertexAttribArray(InstanceAttrib + col);
+        glVertexAttribDivisor(InstanceAttrib + col, 1);
+    }
+    for (GLuint col = 0; col < 3; ++col) {
+        glEnableVertexAttribArray(NormalAttrib + col);
+        glVertexAttribDivisor(NormalAttrib + col, 1);
+    }
+    glEnableVertexAttribArray(DrawAttrib);
+    glVertexAttribDivisor(DrawAttrib, 1);
+    bindInstanceAttribs(0);
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    vertices = std::vector<MeshVertex>();
+    indices = std::vector<std::uint32_t>();
+}
+
+void MeshBatch::bindInstanceAttribs(GLintptr base) const {
+    const GLsizei stride = sizeof(BatchInstance);
+    for (GLuint col = 0; col < 4; ++col) {
+        glVertexAttribPointer(InstanceAttrib + col, 4, GL_FLOAT, GL_FALSE, stride,
+            (void*)(base + offsetof(BatchInstance, model) + sizeof(glm::vec4) * col));
+    }
+    for (GLuint col = 0; col < 3; ++col) {
+        glVertexAttribPointer(NormalAttrib + col, 3, GL_FLOAT, GL_FALSE, stride,
+            (void*)(base + offsetof(BatchInstance, normalMatrix) + sizeof(glm::vec3) * col));
+    }
+    glVertexAttribIPointer(DrawAttrib, 1, GL_UNSIGNED_INT, stride,
+        (void*)(base + offsetof(BatchInstance, draw)));
+}
+
+void MeshBatch::clear() {
+    commands.clear();
+    instances.clear();
+    drawMaterials.clear();
+}
+
+void MeshBatch::add(int mesh, int level, int material, const InstanceData* data, GLsizei count) {
+    if (count <= 0) return;
+    const Range& range = meshes[mesh][level];
+    const GLuint draw = (GLuint)commands.size();
+    commands.push_back({ range.indexCount, (GLuint)count, range.firstIndex, range.baseVertex,
+        (GLuint)instances.size() });
+    drawMaterials.push_back(materials[material]);
+    for (GLsizei i = 0; i < count; ++i)
+        instances.push_back({ data[i].model, data[i].normalMatrix, draw });
+}
+
+void MeshBatch::draw(const ShaderProgram& shader, GLuint textureArray) {
+    triangles = 0;
+    if (commands.empty()) return;
+    for (const DrawElementsIndirectCommand& command : commands)
+        triangles += (long long)(command.count / 3) * command.instanceCount;
+
+    const std::size_t instanceBytes = instances.size() * sizeof(BatchInstance);
+    const std::size_t materialBytes = drawMaterials.size() * sizeof(glm::uvec2);
+    const std::size_t commandBytes = commands.size() * sizeof(DrawElementsIndirectCommand);
+
+    // Straight into this frame's region of the stream buffer, or the
+    // batch's own buffers if it is full
+    auto put = [this](const void* data, std::size_t bytes, std::size_t alignment) {
+        StreamAllocation slot;
+        if (stream) slot = stream->allocate(bytes, alignment);
+        if (slot) {
+            std::memcpy(slot.data, data, bytes);
+            stream->commit(slot);
+        }
+        return slot;
+    };
+    StreamAllocation instanceSlot = put(instances.data(), instanceBytes, 16);
+    StreamAllocation materialSlot = put(drawMaterials.data(), materialBytes,
+        stream ? stream->alignmentFor(GL_SHADER_STORAGE_BUFFER) : 16);
+    StreamAllocation commandSlot = put(commands.data(), commandBytes, 16);
+
+    GLuint instanceSource = instanceVbo, commandSource = commandBuffer;
+    GLintptr instanceBase = 0, commandBase = 0;
+    if (instanceSlot && materialSlot && commandSlot) {
+        instanceSource = instanceSlot.buffer;
+        instanceBase = instanceSlot.offset;
+        commandSource = commandSlot.buffer;
+        commandBase = commandSlot.offset;
+        glBindBufferRange(GL_SHADER_STORAGE_BUFFER, MaterialBinding, materialSlot.buffer,
+            materialSlot.offset, (GLsizeiptr)materialBytes);
+    } else {
+        orphanUpload(GL_ARRAY_BUFFER, instanceVbo, instances.data(), instanceBytes);
+        orphanUpload(GL_SHADER_STORAGE_BUFFER, materialBuffer, drawMaterials.data(), materialBytes);
+        orphanUpload(GL_DRAW_INDIRECT_BUFFER, commandBuffer, commands.data(), commandBytes);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, MaterialBinding, materialBuffer);
+    }
+
+    shader.Activate();
+    glActiveTexture(GL_TEXTURE0 + TextureUnit);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, textureArray);
+    glActiveTexture(GL_TEXTURE0);
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, instanceSource);
+    bindInstanceAttribs(instanceBase);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, commandSource);
+    glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, (void*)commandBase,
+        (GLsizei)commands.size(), 0);
+    glBindVertexArray(0);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+}
+
+void MeshBatch::Delete() {
+    if (vao) glDeleteVertexArrays(1, &vao);
+    const GLuint buffers[] = { vbo, ebo, instanceVbo, commandBuffer, materialBuffer };
+    for (GLuint buffer : buffers)
+        if (buffer) glDeleteBuffers(1, &buffer);
+    vao = vbo = ebo = instanceVbo = commandBuffer = materialBuffer = 0;
+}
@@ -0,0 +1,111 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include "InstancedMesh.h"
+#include "MeshData.h"
+#include "ShaderProgram.h"
+#include "StreamBuffer.h"
+
+// Layout glMultiDrawElementsIndirect reads for each draw
+struct DrawElementsIndirectCommand {
+    GLuint count;
+    GLuint instanceCount;
+    GLuint firstIndex;
+    GLint baseVertex;
+    GLuint baseInstance;
+};
+static_assert(sizeof(DrawElementsIndirectCommand) == 20, "Indirect command must be tightly packed");
+
+// Per-instance vertex data of a batched draw (attribute locations 4-11)
+struct BatchInstance {
+    glm::mat4 model;
+    glm::mat3 normalMatrix;
+    GLuint draw; // command index, picks the draw's material
+};
+
+// Every mesh in one vertex and index buffer, drawn as a single
+// glMultiDrawElementsIndirect per flush. Each command is a mesh LOD with
+// a material: its diffuse and specular layers of a texture array, read by
+// the vertex shader from a per-draw storage buffer through the instance's
+// command index. Commands can each use a different mesh and material and
+// still cost one draw call. Needs GL 4.3 (indirect multi-draw with base
+// instance, storage buffers); check supported() before building one.
+class MeshBatch {
+public:
+    static constexpr GLuint InstanceAttrib = InstancedMesh::InstanceAttrib;
+    static constexpr GLuint NormalAttrib = InstancedMesh::NormalAttrib;
+    static constexpr GLuint DrawAttrib = 11;
+    // Storage buffer binding of the per-draw materials ("DrawMaterials")
+    static constexpr GLuint MaterialBinding = 0;
+    // Texture unit of the materialArray sampler
+    static constexpr GLint TextureUnit = 3;
+
+    // Asks the current context
+    static bool supported();
+
+    // Appends every LOD of the mesh; returns its id. Call before build().
+    int addMesh(const MeshView& mesh);
+    int levelCount(int mesh) const { return (int)meshes[mesh].size(); }
+    // Texture array layers a material samples
+    int addMaterial(int diffuseLayer, int specularLayer);
+    int materialCount() const { return (int)materials.size(); }
+    // Uploads the merged geometry and drops the CPU copy
+    void build();
+
+    // Commands, instances and materials go through the per-frame stream
+    // buffer when it has room
+    void setStream(StreamBuffer* buffer) { stream = buffer; }
+
+    // Starts a new set of commands
+    void clear();
+    // One command: count instances of a mesh LOD with one material
+    void add(int mesh, int level, int material, const InstanceData* instances, GLsizei count);
+    // Uploads the commands and their instances and materials, then issues
+    // them all with one call
+    void draw(const ShaderProgram& shader, GLuint textureArray);
+
+    int commandCount() const { return (int)commands.size(); }
+    // Triangles submitted by the last draw
+    long long trianglesDrawn() const { return triangles; }
+
+    void Delete();
+
+private:
+    // Where one LOD of a mesh sits in the merged buffers
+    struct Range {
+        GLuint firstIndex;
+        GLuint indexCount;
+        GLint baseVertex;
+    };
+
+    // Expects the VAO and the instance source to be bound
+    void bindInstanceAttribs(GLintptr base) const;
+
+    std::vector<std::vector<Range>> meshes; // per mesh, per LOD
+    std::vector<glm::uvec2> materials;      // diffuse, specular layer
+    std::vector<MeshVertex> vertices;       // until build()
+    std::vector<std::uint32_t> indices;
+
+    std::vector<DrawElementsIndirectCommand> commands;
+    std::vector<BatchInstance> instances;
+    std::vector<glm::uvec2> drawMaterials;  // per command
+
+    GLuint vao = 0;
+    GLuint vbo = 0;
+    GLuint ebo = 0;
+    GLuint instanceVbo = 0;
+    GLuint commandBuffer = 0;
+    GLuint materialBuffer = 0;
+    StreamBuffer* stream = nullptr;
+    long long triangles = 0;
+};
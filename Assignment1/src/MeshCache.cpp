@@ -0,0 +1,206 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#include "MeshCache.h"
+
+#include <cstring>
+#include <iostream>
+
+#include "MeshOptimizer.h"
+#include "MeshSimplifier.h"
+
+namespace {
+
+struct MeshCacheHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t vertexStride;
+    std::uint64_t sourceSize;
+    std::uint64_t sourceHash;
+    std::uint32_t vertexCount;
+    std::uint32_t indexCount;
+    std::uint32_t textureCount;
+    std::uint32_t stringBytes;
+    std::uint32_t indexSize;
+    std::uint32_t lodCount;
+    std::uint64_t lodOffset;
+    std::uint64_t vertexOffset;
+    std::uint64_t indexOffset;
+    float boundsMin[3];
+    float boundsMax[3];
+    float sphere[4];
+};
+
+const char CacheMagic[8] = { 'R', 'T', 'A', 'M', 'E', 'S', 'H', '\0' };
+
+std::size_t alignUp(std::size_t value, std::size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+// Chains the contents of every "mtllib" the OBJ names onto seed, so an
+// edited material library invalidates the cache too. A missing library
+// contributes its name, so one appearing later also counts as a change.
+std::uint64_t hashMaterialLibraries(const MappedFile& source, const std::string& directory,
+    std::uint64_t seed) {
+    const char* text = reinterpret_cast<const char*>(source.data());
+    const char* end = text + source.size();
+    for (const char* line = text; line < end;) {
+        const char* lineEnd = static_cast<const char*>(std::memchr(line, '\n', (std::size_t)(end - line)));
+        if (!lineEnd) lineEnd = end;
+        if (lineEnd - line > 7 && std::memcmp(line, "mtllib ", 7) == 0) {
+            std::string name(line + 7, lineEnd);
+            while (!name.empty() && (name.back() == '\r' || name.back() == ' ')) name.pop_back();
+            MappedFile library(directory + name);
+            seed = library.isOpen() ? hashBytes(library.data(), library.size(), seed)
+                                    : hashBytes(name.data(), name.size(), seed);
+        }
+        line = lineEnd + 1;
+    }
+    return seed;
+}
+
+} // namespace
+
+bool MeshCache::open(const std::string& sourcePath) {
+    close();
+
+    MappedFile source(sourcePath);
+    if (!source.isOpen()) {
+        std::cerr << "[Mesh] Failed to open " << sourcePath << std::endl;
+        return false;
+    }
+    std::uint64_t sourceSize = source.size();
+    std::uint64_t sourceHash = hashBytes(source.data(), source.size());
+    sourceHash = hashMaterialLibraries(source, sourcePath.substr(0, sourcePath.find_last_of("/\\") + 1),
+        sourceHash);
+    source.close();
+
+    const std::string path = cachePath(sourcePath);
+    if (mapCache(path, sourceSize, sourceHash)) return true;
+
+    // Missing or stale: parse the source once and write a fresh cache
+    wasRebuilt = true;
+    MeshData mesh;
+    if (!loadObj(sourcePath, mesh)) return false;
+    printReport(optimizeMesh(mesh), sourcePath.c_str());
+    buildLodChain(mesh);
+    for (std::size_t i = 0; i < mesh.lods.size(); ++i)
+        std::cout << "[Mesh]   LOD" << i << ": " << mesh.lods[i].indexCount / 3
+                  << " triangles, error " << mesh.lods[i].error << "\n";
+
+    if (write(path, mesh, sourceSize, sourceHash) && mapCache(path, sourceSize, sourceHash))
+        return true;
+
+    std::cerr << "[Mesh] Could not write " << path << ", using parsed mesh" << std::endl;
+    fallback = std::move(mesh);
+    meshView = MeshView(fallback);
+    texturePaths = fallback.textures;
+    return true;
+}
+
+void MeshCache::close() {
+    file.close();
+    fallback = MeshData();
+    meshView = MeshView();
+    texturePaths.clear();
+    wasRebuilt = false;
+}
+
+bool MeshCache::mapCache(const std::string& path, std::uint64_t sourceSize,
+    std::uint64_t sourceHash) {
+    if (!file.open(path)) return false;
+
+    MeshCacheHeader header;
+    if (file.size() < sizeof(header)) { file.close(); return false; }
+    std::memcpy(&header, file.data(), sizeof(header));
+
+    bool valid = std::memcmp(header.magic, CacheMagic, sizeof(CacheMagic)) == 0 &&
+        header.version == Version &&
+        header.vertexStride == sizeof(MeshVertex) &&
+        (header.indexSize == 2 || header.indexSize == 4) &&
+        header.sourceSize == sourceSize &&
+        header.sourceHash == sourceHash &&
+        header.vertexOffset + (std::uint64_t)header.vertexCount * sizeof(MeshVertex) <= file.size() &&
+        header.indexOffset + (std::uint64_t)header.indexCount * header.indexSize <= file.size() &&
+        sizeof(header) + header.stringBytes <= header.lodOffset &&
+        header.lodOffset + (std::uint64_t)header.lodCount * sizeof(MeshLod) <= header.vertexOffset;
+    if (valid) {
+        // LOD ranges must stay inside the index list
+        const MeshLod* lods = reinterpret_cast<const MeshLod*>(file.data() + header.lodOffset);
+        for (std::uint32_t i = 0; i < header.lodCount && valid; ++i)
+            valid = (std::uint64_t)lods[i].indexOffset + lods[i].indexCount <= header.indexCount;
+    }
+    if (!valid) { file.close(); return false; }
+
+    // Texture references: packed null-terminated strings after the header
+    const char* str = reinterpret_cast<const char*>(file.data() + sizeof(header));
+    const char* strEnd = str + header.stringBytes;
+    for (std::uint32_t i = 0; i < header.textureCount && str < strEnd; ++i) {
+        texturePaths.emplace_back(str);
+        str += texturePaths.back().size() + 1;
+    }
+
+    meshView.vertices = reinterpret_cast<const MeshVertex*>(file.data() + header.vertexOffset);
+    meshView.vertexCount = header.vertexCount;
+    meshView.indices = file.data() + header.indexOffset;
+    meshView.indexCount = header.indexCount;
+    meshView.indexSize = header.indexSize;
+    meshView.lods = reinterpret_cast<const MeshLod*>(file.data() + header.lodOffset);
+    meshView.lodCount = header.lodCount;
+    meshView.bounds.box.min = glm::vec3(header.boundsMin[0], header.boundsMin[1], header.boundsMin[2]);
+    meshView.bounds.box.max = glm::vec3(header.boundsMax[0], header.boundsMax[1], header.boundsMax[2]);
+    meshView.bounds.sphere = glm::vec4(header.sphere[0], header.sphere[1], header.sphere[2], header.sphere[3]);
+    return true;
+}
+
+bool MeshCache::write(const std::string& path, const MeshData& mesh,
+    std::uint64_t sourceSize, std::uint64_t sourceHash) {
+    MeshCacheHeader header = {};
+    std::memcpy(header.magic, CacheMagic, sizeof(CacheMagic));
+    header.version = Version;
+    header.vertexStride = sizeof(MeshVertex);
+    header.sourceSize = sourceSize;
+    header.sourceHash = sourceHash;
+    header.vertexCount = (std::uint32_t)mesh.vertices.size();
+    header.indexCount = (std::uint32_t)mesh.indices.size();
+    header.textureCount = (std::uint32_t)mesh.textures.size();
+    header.indexSize = indexSizeFor(mesh.vertices.size());
+    header.lodCount = (std::uint32_t)mesh.lods.size();
+    for (int i = 0; i < 3; ++i) {
+        header.boundsMin[i] = mesh.bounds.box.min[i];
+        header.boundsMax[i] = mesh.bounds.box.max[i];
+    }
+    for (int i = 0; i < 4; ++i) header.sphere[i] = mesh.bounds.sphere[i];
+
+    std::string strings;
+    for (const std::string& tex : mesh.textures) {
+        strings += tex;
+        strings.push_back('\0');
+    }
+    header.stringBytes = (std::uint32_t)strings.size();
+
+    // Keep the arrays 16-byte aligned so the mapping can be used in place
+    header.lodOffset = alignUp(sizeof(header) + strings.size(), 16);
+    header.vertexOffset = alignUp(header.lodOffset + mesh.lods.size() * sizeof(MeshLod), 16);
+    header.indexOffset = alignUp(header.vertexOffset + mesh.vertices.size() * sizeof(MeshVertex), 16);
+    std::size_t total = header.indexOffset + mesh.indices.size() * header.indexSize;
+
+    std::vector<unsigned char> bytes(total, 0);
+    std::memcpy(bytes.data(), &header, sizeof(header));
+    std::memcpy(bytes.data() + sizeof(header), strings.data(), strings.size());
+    std::memcpy(bytes.data() + header.lodOffset, mesh.lods.data(), mesh.lods.size() * sizeof(MeshLod));
+    std::memcpy(bytes.data() + header.vertexOffset, mesh.vertices.data(),
+        mesh.vertices.size() * sizeof(MeshVertex));
+    if (header.indexSize == 2) {
+        std::uint16_t* out = reinterpret_cast<std::uint16_t*>(bytes.data() + header.indexOffset);
+        for (std::size_t i = 0; i < mesh.indices.size(); ++i) out[i] = (std::uint16_t)mesh.indices[i];
+    } else {
+        std::memcpy(bytes.data() + header.indexOffset, mesh.indices.data(),
+            mesh.indices.size() * sizeof(std::uint32_t));
+    }
+
+    return writeFileAtomic(path, bytes.data(), bytes.size());
+}
@@ -0,0 +1,52 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "FileUtils.h"
+#include "MeshData.h"
+
+// Binary, memory-mapped copy of a parsed mesh stored next to its source as
+// <source>.meshcache. The header records the source size and a hash of its
+// contents and of the material libraries it names, so an edited source or
+// .mtl (or a cache from an older build) is rebuilt on open.
+// The stored mesh has been through optimizeMesh (MeshOptimizer.h), carries
+// its LOD chain (MeshSimplifier.h) and object-space bounds, and uses 16-bit
+// indices when it has few enough vertices.
+class MeshCache {
+public:
+    static constexpr std::uint32_t Version = 4;
+
+    MeshCache() = default;
+    explicit MeshCache(const std::string& sourcePath) { open(sourcePath); }
+
+    // Maps the cache for sourcePath, rebuilding it from the OBJ if needed
+    bool open(const std::string& sourcePath);
+    // Releases the mapping; views returned earlier become invalid
+    void close();
+
+    bool isOpen() const { return meshView.indexCount > 0; }
+    // True when this open() had to parse the source
+    bool rebuilt() const { return wasRebuilt; }
+    const MeshView& view() const { return meshView; }
+    const std::vector<std::string>& textures() const { return texturePaths; }
+
+    static std::string cachePath(const std::string& sourcePath) { return sourcePath + ".meshcache"; }
+    static bool write(const std::string& path, const MeshData& mesh,
+        std::uint64_t sourceSize, std::uint64_t sourceHash);
+
+private:
+    bool mapCache(const std::string& path, std::uint64_t sourceSize, std::uint64_t sourceHash);
+
+    MappedFile file;
+    MeshData fallback; // only used if the cache could not be written
+    MeshView meshView;
+    std::vector<std::string> texturePaths;
+    bool wasRebuilt = false;
+};
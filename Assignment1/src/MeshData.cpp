@@ -0,0 +1,200 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#include "MeshData.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <unordered_map>
+
+namespace {
+
+struct CornerKey {
+    int v, vt, vn;
+    bool operator==(const CornerKey& o) const { return v == o.v && vt == o.vt && vn == o.vn; }
+};
+
+struct CornerHash {
+    std::size_t operator()(const CornerKey& k) const {
+        return (std::size_t)k.v * 73856093u ^ (std::size_t)k.vt * 19349663u ^ (std::size_t)k.vn * 83492791u;
+    }
+};
+
+// OBJ indices are 1-based and may be negative (relative to the end)
+int resolveIndex(const char* s, char** end, int count) {
+    long i = std::strtol(s, end, 10);
+    if (*end == s) return -1;
+    return i < 0 ? count + (int)i : (int)i - 1;
+}
+
+// Parses "v", "v/vt", "v//vn" or "v/vt/vn"
+bool parseCorner(const char*& p, int vCount, int tCount, int nCount, CornerKey& key) {
+    while (*p == ' ' || *p == '\t') ++p;
+    if (*p == '\0' || *p == '\r' || *p == '\n') return false;
+
+    char* end = nullptr;
+    key = { resolveIndex(p, &end, vCount), -1, -1 };
+    if (key.v < 0) return false;
+    p = end;
+    if (*p == '/') {
+        ++p;
+        if (*p != '/') { key.vt = resolveIndex(p, &end, tCount); p = end; }
+        if (*p == '/') { ++p; key.vn = resolveIndex(p, &end, nCount); p = end; }
+    }
+    while (*p && *p != ' ' && *p != '\t') ++p;
+    return true;
+}
+
+// Collects every map_* / bump / norm path from a .mtl file
+void readMaterialTextures(const std::string& mtlPath, std::vector<std::string>& textures) {
+    std::ifstream file(mtlPath);
+    if (!file) return;
+
+    std::string line;
+    while (std::getline(file, line)) {
+        std::size_t start = line.find_first_not_of(" \t");
+        if (start == std::string::npos) continue;
+        bool isMap = line.compare(start, 4, "map_") == 0 || line.compare(start, 5, "bump ") == 0 ||
+            line.compare(start, 5, "norm ") == 0;
+        if (!isMap) continue;
+
+        // Options may precede the file name, which is always last
+        std::size_t end = line.find_last_not_of(" \t\r");
+        std::size_t nameStart = line.find_last_of(" \t", end);
+        std::string name = line.substr(nameStart + 1, end - nameStart);
+        if (std::find(textures.begin(), textures.end(), name) == textures.end())
+            textures.push_back(name);
+    }
+}
+
+} // namespace
+
+bool loadObj(const std::string& path, MeshData& out, const glm::vec3& color) {
+    std::ifstream file(path);
+    if (!file) {
+        std::cerr << "[Mesh] Failed to open " << path << std::endl;
+        return false;
+    }
+
+    std::vector<glm::vec3> positions;
+    std::vector<glm::vec2> texCoords;
+    std::vector<glm::vec3> normals;
+    std::unordered_map<CornerKey, std::uint32_t, CornerHash> cornerMap;
+    std::vector<std::uint32_t> polygon;
+
+    out.vertices.clear();
+    out.indices.clear();
+    out.textures.clear();
+
+    std::string directory = path.substr(0, path.find_last_of("/\\") + 1);
+
+    std::string line;
+    while (std::getline(file, line)) {
+        const char* p = line.c_str();
+        if (p[0] == 'v' && p[1] == ' ') {
+            glm::vec3 v;
+            char* end = nullptr;
+            v.x = std::strtof(p + 2, &end);
+            v.y = std::strtof(end, &end);
+            v.z = std::strtof(end, &end);
+            positions.push_back(v);
+        } else if (p[0] == 'v' && p[1] == 't') {
+            glm::vec2 t;
+            char* end = nullptr;
+            t.x = std::strtof(p + 3, &end);
+            t.y = std::strtof(end, &end);
+            texCoords.push_back(t);
+        } else if (p[0] == 'v' && p[1] == 'n') {
+            glm::vec3 n;
+            char* end = nullptr;
+            n.x = std::strtof(p + 3, &end);
+            n.y = std::strtof(end, &end);
+            n.z = std::strtof(end, &end);
+            normals.push_back(n);
+        } else if (line.compare(0, 7, "mtllib ") == 0) {
+            std::string name = line.substr(7);
+            while (!name.empty() && (name.back() == '\r' || name.back() == ' ')) name.pop_back();
+            readMaterialTextures(directory + name, out.textures);
+        } else if (p[0] == 'f' && p[1] == ' ') {
+            polygon.clear();
+            p += 2;
+            CornerKey key;
+            while (parseCorner(p, (int)positions.size(), (int)texCoords.size(),
+                (int)normals.size(), key)) {
+                if (key.v >= (int)positions.size()) break;
+
+                auto it = cornerMap.find(key);
+                if (it == cornerMap.end()) {
+                    MeshVertex vert;
+                    vert.position = positions[key.v];
+                    vert.normal = key.vn >= 0 && key.vn < (int)normals.size() ? normals[key.vn] : glm::vec3(0.0f);
+                    vert.color = color;
+                    vert.texUV = key.vt >= 0 && key.vt < (int)texCoords.size() ? texCoords[key.vt] : glm::vec2(0.0f);
+
+                    it = cornerMap.emplace(key, (std::uint32_t)out.vertices.size()).first;
+                    out.vertices.push_back(vert);
+                }
+                polygon.push_back(it->second);
+            }
+
+            // Triangulate as a fan around the first corner
+            for (std::size_t i = 2; i < polygon.size(); ++i) {
+                out.indices.push_back(polygon[0]);
+                out.indices.push_back(polygon[i - 1]);
+                out.indices.push_back(polygon[i]);
+            }
+        }
+    }
+
+    // Fill in face normals for corners the file did not give one
+    for (std::size_t i = 0; i + 2 < out.indices.size(); i += 3) {
+        MeshVertex* tri[3] = { &out.vertices[out.indices[i]],
+            &out.vertices[out.indices[i + 1]], &out.vertices[out.indices[i + 2]] };
+        glm::vec3 faceNormal = glm::cross(tri[1]->position - tri[0]->position,
+            tri[2]->position - tri[0]->position);
+        // Degenerate triangles keep 0 and may be filled by a neighbour
+        float length = glm::length(faceNormal);
+        if (length <= 0.0f) continue;
+        faceNormal /= length;
+        for (MeshVertex* v : tri)
+            if (v->normal == glm::vec3(0.0f)) v->normal = faceNormal;
+    }
+
+    out.bounds = computeBounds(MeshView(out));
+    return !out.empty();
+}
+
+glm::vec4 boundingSphere(const MeshView& mesh) {
+    if (mesh.vertexCount == 0) return glm::vec4(0.0f);
+
+    // Start from the two extreme points along x, then grow to fit
+    const MeshVertex* v = mesh.vertices;
+    std::size_t minX = 0, maxX = 0;
+    for (std::size_t i = 1; i < mesh.vertexCount; ++i) {
+        if (v[i].position.x < v[minX].position.x) minX = i;
+        if (v[i].position.x > v[maxX].position.x) maxX = i;
+    }
+    glm::vec3 center = (v[minX].position + v[maxX].position) * 0.5f;
+    float radius = glm::length(v[maxX].position - center);
+
+    for (std::size_t i = 0; i < mesh.vertexCount; ++i) {
+        float d = glm::length(v[i].position - center);
+        if (d <= radius) continue;
+        float grown = (radius + d) * 0.5f;
+        center += (v[i].position - center) * ((grown - radius) / d);
+        radius = grown;
+    }
+    return glm::vec4(center, radius);
+}
+
+MeshBounds computeBounds(const MeshView& mesh) {
+    MeshBounds bounds;
+    for (std::size_t i = 0; i < mesh.vertexCount; ++i) bounds.box.grow(mesh.vertices[i].position);
+    bounds.sphere = boundingSphere(mesh);
+    return bounds;
+}
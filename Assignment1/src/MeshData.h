@@ -0,0 +1,96 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+#include "Bounds.h"
+
+// Same attribute layout as the engine's scene shaders (locations 0-3)
+struct MeshVertex {
+    glm::vec3 position;
+    glm::vec3 normal;
+    glm::vec3 color;
+    glm::vec2 texUV;
+};
+
+// Index range of one level of detail inside the mesh's index list
+struct MeshLod {
+    std::uint32_t indexOffset = 0;
+    std::uint32_t indexCount = 0;
+    float error = 0.0f; // object-space deviation from LOD 0
+};
+
+// Object-space bounds, computed once when the mesh is loaded
+struct MeshBounds {
+    Aabb box;
+    glm::vec4 sphere = glm::vec4(0.0f); // centre xyz, radius w
+};
+
+// CPU-side triangle mesh, ready to be copied into GL buffers
+struct MeshData {
+    std::vector<MeshVertex> vertices;
+    std::vector<std::uint32_t> indices;
+    // Levels of detail over indices, finest first; empty means one level
+    std::vector<MeshLod> lods;
+    // Texture paths referenced by the material library, relative to the mesh
+    std::vector<std::string> textures;
+    MeshBounds bounds;
+
+    bool empty() const { return indices.empty(); }
+    std::size_t triangleCount() const { return indices.size() / 3; }
+};
+
+// Non-owning view of mesh arrays, either from a MeshData or a mapped cache.
+// Cached meshes may store 16-bit indices; MeshData is always 32-bit.
+struct MeshView {
+    const MeshVertex* vertices = nullptr;
+    std::size_t vertexCount = 0;
+    const void* indices = nullptr;
+    std::size_t indexCount = 0;
+    std::uint32_t indexSize = 4; // bytes per index: 2 or 4
+    const MeshLod* lods = nullptr;
+    std::size_t lodCount = 0;
+    MeshBounds bounds;
+
+    MeshView() = default;
+    MeshView(const MeshData& mesh)
+        : vertices(mesh.vertices.data()), vertexCount(mesh.vertices.size()),
+          indices(mesh.indices.data()), indexCount(mesh.indices.size()),
+          lods(mesh.lods.data()), lodCount(mesh.lods.size()), bounds(mesh.bounds) {}
+
+    std::size_t levelCount() const { return lodCount ? lodCount : 1; }
+    // Level i, or the whole index list for a mesh without LODs
+    MeshLod level(std::size_t i) const {
+        if (lodCount) return lods[i];
+        MeshLod all;
+        all.indexCount = (std::uint32_t)indexCount;
+        return all;
+    }
+
+    std::uint32_t index(std::size_t i) const {
+        return indexSize == 2 ? static_cast<const std::uint16_t*>(indices)[i]
+                              : static_cast<const std::uint32_t*>(indices)[i];
+    }
+    std::size_t indexBytes() const { return indexCount * indexSize; }
+};
+
+// Centre (xyz) and radius (w) of a sphere around every vertex; Ritter's
+// approximation, within a few percent of the minimal sphere
+glm::vec4 boundingSphere(const MeshView& mesh);
+
+// Box and sphere around every vertex
+MeshBounds computeBounds(const MeshView& mesh);
+
+// Minimal OBJ reader: v/vt/vn/f with polygon fans, one merged mesh.
+// Corners sharing the same v/vt/vn triple share a vertex. Texture maps
+// are collected from the mtllib when it is present. Fills in bounds.
+bool loadObj(const std::string& path, MeshData& out,
+    const glm::vec3& color = glm::vec3(0.8f));
@@ -0,0 +1,359 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#include "MeshOptimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <unordered_map>
+
+#include "FileUtils.h"
+
+namespace {
+
+const std::uint32_t Unused = 0xFFFFFFFFu;
+
+// -------------------- Forsyth scoring --------------------
+
+const int CacheSize = 32;
+const float CacheDecayPower = 1.5f;
+const float LastTriScore = 0.75f;
+const float ValenceBoostScale = 2.0f;
+const float ValenceBoostPower = 0.5f;
+
+float vertexScore(int cachePosition, std::uint32_t remainingTriangles) {
+    // No triangles left to draw: nothing to gain from this vertex
+    if (remainingTriangles == 0) return -1.0f;
+
+    float score = 0.0f;
+    if (cachePosition >= 0) {
+        if (cachePosition < 3) {
+            // Used by the last triangle; fixed score so the order of those
+            // three does not matter
+            score = LastTriScore;
+        } else {
+            float scale = 1.0f / (CacheSize - 3);
+            score = std::pow(1.0f - (cachePosition - 3) * scale, CacheDecayPower);
+        }
+    }
+    // Favour vertices with few triangles left so they get finished off
+    score += ValenceBoostScale * std::pow((float)remainingTriangles, -ValenceBoostPower);
+    return score;
+}
+
+// -------------------- Welding --------------------
+
+struct VertexKeyHash {
+    std::size_t operator()(const MeshVertex& v) const {
+        return (std::size_t)hashBytes(reinterpret_cast<const unsigned char*>(&v), sizeof(v));
+    }
+};
+
+struct VertexKeyEqual {
+    bool operator()(const MeshVertex& a, const MeshVertex& b) const {
+        return std::memcmp(&a, &b, sizeof(MeshVertex)) == 0;
+    }
+};
+
+} // namespace
+
+// -------------------- Analysis --------------------
+
+VertexCacheStats analyzeVertexCache(const std::uint32_t* indices, std::size_t indexCount,
+    std::size_t vertexCount, unsigned cacheSize) {
+    VertexCacheStats stats;
+    if (indexCount < 3 || vertexCount == 0) return stats;
+
+    // FIFO: a vertex is a hit if it was inserted within the last cacheSize misses
+    std::vector<std::size_t> insertedAt(vertexCount, 0);
+    std::size_t misses = 0;
+    for (std::size_t i = 0; i < indexCount; ++i) {
+        std::uint32_t v = indices[i];
+        if (misses - insertedAt[v] >= cacheSize || insertedAt[v] == 0) {
+            misses++;
+            insertedAt[v] = misses;
+        }
+    }
+
+    std::vector<char> used(vertexCount, 0);
+    std::size_t unique = 0;
+    for (std::size_t i = 0; i < indexCount; ++i)
+        if (!used[indices[i]]) { used[indices[i]] = 1; unique++; }
+
+    stats.acmr = (float)misses / (float)(indexCount / 3);
+    stats.atvr = unique ? (float)misses / (float)unique : 0.0f;
+    return stats;
+}
+
+// -------------------- Weld --------------------
+
+std::size_t weldVertices(MeshData& mesh) {
+    std::unordered_map<MeshVertex, std::uint32_t, VertexKeyHash, VertexKeyEqual> lookup;
+    lookup.reserve(mesh.vertices.size());
+
+    std::vector<MeshVertex> welded;
+    welded.reserve(mesh.vertices.size());
+    std::vector<std::uint32_t> remap(mesh.vertices.size());
+    for (std::size_t i = 0; i < mesh.vertices.size(); ++i) {
+        auto it = lookup.emplace(mesh.vertices[i], (std::uint32_t)welded.size());
+        if (it.second) welded.push_back(mesh.vertices[i]);
+        remap[i] = it.first->second;
+    }
+
+    // Drop triangles that now reference the same vertex twice
+    std::vector<std::uint32_t> indices;
+    indices.reserve(mesh.indices.size());
+    for (std::size_t i = 0; i + 2 < mesh.indices.size(); i += 3) {
+        std::uint32_t a = remap[mesh.indices[i]];
+        std::uint32_t b = remap[mesh.indices[i + 1]];
+        std::uint32_t c = remap[mesh.indices[i + 2]];
+        if (a == b || b == c || a == c) continue;
+        indices.push_back(a);
+        indices.push_back(b);
+        indices.push_back(c);
+    }
+
+    std::size_t removed = mesh.vertices.size() - welded.size();
+    mesh.vertices = std::move(welded);
+    mesh.indices = std::move(indices);
+    return removed;
+}
+
+// -------------------- Vertex cache --------------------
+
+void optimizeVertexCache(std::vector<std::uint32_t>& indices, std::size_t vertexCount) {
+    const std::size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0) return;
+
+    // Vertex -> triangle adjacency, compacted as triangles are emitted
+    std::vector<std::uint32_t> remaining(vertexCount, 0);
+    for (std::uint32_t v : indices) remaining[v]++;
+    std::vector<std::uint32_t> offsets(vertexCount + 1, 0);
+    for (std::size_t v = 0; v < vertexCount; ++v) offsets[v + 1] = offsets[v] + remaining[v];
+    std::vector<std::uint32_t> adjacency(indices.size());
+    {
+        std::vector<std::uint32_t> fill(offsets.begin(), offsets.end() - 1);
+        for (std::size_t t = 0; t < triangleCount; ++t)
+            for (int k = 0; k < 3; ++k)
+                adjacency[fill[indices[t * 3 + k]]++] = (std::uint32_t)t;
+    }
+
+    std::vector<int> cachePosition(vertexCount, -1);
+    std::vector<float> score(vertexCount);
+    for (std::size_t v = 0; v < vertexCount; ++v) score[v] = vertexScore(-1, remaining[v]);
+
+    std::vector<float> triangleScore(triangleCount);
+    std::vector<char> emitted(triangleCount, 0);
+    for (std::size_t t = 0; t < triangleCount; ++t)
+        triangleScore[t] = score[indices[t * 3]] + score[indices[t * 3 + 1]] + score[indices[t * 3 + 2]];
+
+    // LRU cache of vertex ids, with room for a new triangle on top
+    std::vector<std::uint32_t> cache, nextCache;
+    cache.reserve(CacheSize + 3);
+    nextCache.reserve(CacheSize + 3);
+
+    std::vector<std::uint32_t> output;
+    output.reserve(indices.size());
+
+    std::size_t scanCursor = 0;
+    std::uint32_t best = Unused;
+    float bestScore = -1.0f;
+    for (std::size_t t = 0; t < triangleCount; ++t)
+        if (triangleScore[t] > bestScore) { bestScore = triangleScore[t]; best = (std::uint32_t)t; }
+
+    while (best != Unused) {
+        emitted[best] = 1;
+        const std::uint32_t* tri = &indices[best * 3];
+        output.insert(output.end(), tri, tri + 3);
+
+        // Remove the triangle from its vertices' adjacency lists
+        for (int k = 0; k < 3; ++k) {
+            std::uint32_t v = tri[k];
+            std::uint32_t* list = &adjacency[offsets[v]];
+            std::uint32_t count = remaining[v];
+            for (std::uint32_t i = 0; i < count; ++i) {
+                if (list[i] == best) {
+                    list[i] = list[count - 1];
+                    break;
+                }
+            }
+            remaining[v]--;
+        }
+
+        // New cache: this triangle's vertices first, then the old order
+        nextCache.assign(tri, tri + 3);
+        for (std::uint32_t v : cache)
+            if (v != tri[0] && v != tri[1] && v != tri[2]) nextCache.push_back(v);
+        std::swap(cache, nextCache);
+
+        // Rescore everything that was or is in the cache; vertices pushed
+        // out get position -1
+        for (std::size_t i = 0; i < cache.size(); ++i) {
+            std::uint32_t v = cache[i];
+            cachePosition[v] = i < (std::size_t)CacheSize ? (int)i : -1;
+            score[v] = vertexScore(cachePosition[v], remaining[v]);
+        }
+        if (cache.size() > (std::size_t)CacheSize) cache.resize(CacheSize);
+
+        // Best candidate among triangles touching the cache
+        best = Unused;
+        bestScore = -1.0f;
+        for (std::uint32_t v : cache) {
+            const std::uint32_t* list = &adjacency[offsets[v]];
+            for (std::uint32_t i = 0; i < remaining[v]; ++i) {
+                std::uint32_t t = list[i];
+                const std::uint32_t* tv = &indices[t * 3];
+                float s = score[tv[0]] + score[tv[1]] + score[tv[2]];
+                triangleScore[t] = s;
+                if (s > bestScore) { bestScore = s; best = t; }
+            }
+        }
+
+        // Cache ran dry (disconnected piece): continue with the next
+        // triangle not yet drawn
+        if (best == Unused) {
+            while (scanCursor < triangleCount && emitted[scanCursor]) scanCursor++;
+            if (scanCursor < triangleCount) best = (std::uint32_t)scanCursor;
+        }
+    }
+
+    indices = std::move(output);
+}
+
+// -------------------- Overdraw --------------------
+
+void optimizeOverdraw(std::vector<std::uint32_t>& indices,
+    const std::vector<MeshVertex>& vertices, unsigned cacheSize) {
+    const std::size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0) return;
+
+    // Cluster boundaries: triangles whose three vertices all miss the
+    // cache. Reordering clusters there costs (almost) nothing in ACMR.
+    std::vector<std::size_t> clusterStart;
+    {
+        std::vector<std::size_t> insertedAt(vertices.size(), 0);
+        std::size_t misses = 0;
+        for (std::size_t t = 0; t < triangleCount; ++t) {
+            int triMisses = 0;
+            for (int k = 0; k < 3; ++k) {
+                std::uint32_t v = indices[t * 3 + k];
+                if (insertedAt[v] == 0 || misses - insertedAt[v] >= cacheSize) {
+                    misses++;
+                    insertedAt[v] = misses;
+                    triMisses++;
+                }
+            }
+            if (t == 0 || triMisses == 3) clusterStart.push_back(t);
+        }
+    }
+    clusterStart.push_back(triangleCount);
+    const std::size_t clusterCount = clusterStart.size() - 1;
+    if (clusterCount < 2) return;
+
+    // Mesh centroid, area weighted
+    glm::vec3 meshCenter(0.0f);
+    float meshArea = 0.0f;
+    for (std::size_t t = 0; t < triangleCount; ++t) {
+        const glm::vec3& a = vertices[indices[t * 3]].position;
+        const glm::vec3& b = vertices[indices[t * 3 + 1]].position;
+        const glm::vec3& c = vertices[indices[t * 3 + 2]].position;
+        float area = glm::length(glm::cross(b - a, c - a));
+        meshCenter += (a + b + c) * (area / 3.0f);
+        meshArea += area;
+    }
+    if (meshArea > 0.0f) meshCenter /= meshArea;
+
+    // How far each cluster faces away from the centre
+    std::vector<float> sortKey(clusterCount);
+    for (std::size_t cl = 0; cl < clusterCount; ++cl) {
+        glm::vec3 center(0.0f), normal(0.0f);
+        float area = 0.0f;
+        for (std::size_t t = clusterStart[cl]; t < clusterStart[cl + 1]; ++t) {
+            const glm::vec3& a = vertices[indices[t * 3]].position;
+            const glm::vec3& b = vertices[indices[t * 3 + 1]].position;
+            const glm::vec3& c = vertices[indices[t * 3 + 2]].position;
+            glm::vec3 n = glm::cross(b - a, c - a);
+            float triArea = glm::length(n);
+            center += (a + b + c) * (triArea / 3.0f);
+            normal += n;
+            area += triArea;
+        }
+        if (area > 0.0f) center /= area;
+        float len = glm::length(normal);
+        if (len > 0.0f) normal /= len;
+        sortKey[cl] = glm::dot(center - meshCenter, normal);
+    }
+
+    std::vector<std::size_t> order(clusterCount);
+    for (std::size_t i = 0; i < clusterCount; ++i) order[i] = i;
+    std::stable_sort(order.begin(), order.end(),
+        [&](std::size_t a, std::size_t b) { return sortKey[a] > sortKey[b]; });
+
+    std::vector<std::uint32_t> output;
+    output.reserve(indices.size());
+    for (std::size_t cl : order)
+        output.insert(output.end(), indices.begin() + clusterStart[cl] * 3,
+            indices.begin() + clusterStart[cl + 1] * 3);
+    indices = std::move(output);
+}
+
+// -------------------- Vertex fetch --------------------
+
+void optimizeVertexFetch(MeshData& mesh) {
+    std::vector<std::uint32_t> remap(mesh.vertices.size(), Unused);
+    std::vector<MeshVertex> ordered;
+    ordered.reserve(mesh.vertices.size());
+
+    for (std::uint32_t& index : mesh.indices) {
+        if (remap[index] == Unused) {
+            remap[index] = (std::uint32_t)ordered.size();
+            ordered.push_back(mesh.vertices[index]);
+        }
+        index = remap[index];
+    }
+    // Vertices no index refers to are dropped
+    mesh.vertices = std::move(ordered);
+}
+
+std::uint32_t indexSizeFor(std::size_t vertexCount) {
+    return vertexCount <= 0x10000 ? 2 : 4;
+}
+
+// -------------------- Pipeline --------------------
+
+MeshOptimizeReport optimizeMesh(MeshData& mesh) {
+    MeshOptimizeReport report;
+    report.verticesBefore = mesh.vertices.size();
+    report.trianglesBefore = mesh.triangleCount();
+    report.cacheBefore = analyzeVertexCache(mesh.indices.data(), mesh.indices.size(), mesh.vertices.size());
+    report.vertexBytesBefore = mesh.vertices.size() * sizeof(MeshVertex);
+    report.indexBytesBefore = mesh.indices.size() * sizeof(std::uint32_t);
+
+    weldVertices(mesh);
+    optimizeVertexCache(mesh.indices, mesh.vertices.size());
+    optimizeOverdraw(mesh.indices, mesh.vertices);
+    optimizeVertexFetch(mesh);
+
+    report.verticesAfter = mesh.vertices.size();
+    report.trianglesAfter = mesh.triangleCount();
+    report.cacheAfter = analyzeVertexCache(mesh.indices.data(), mesh.indices.size(), mesh.vertices.size());
+    report.vertexBytesAfter = mesh.vertices.size() * sizeof(MeshVertex);
+    report.indexBytesAfter = mesh.indices.size() * indexSizeFor(mesh.vertices.size());
+    return report;
+}
+
+void printReport(const MeshOptimizeReport& r, const char* name) {
+    std::cout << "[Mesh] Optimized " << name << ": "
+              << r.verticesBefore << " -> " << r.verticesAfter << " vertices, "
+              << r.trianglesBefore << " -> " << r.trianglesAfter << " triangles\n"
+              << "[Mesh]   ACMR " << r.cacheBefore.acmr << " -> " << r.cacheAfter.acmr
+              << ", ATVR " << r.cacheBefore.atvr << " -> " << r.cacheAfter.atvr << "\n"
+              << "[Mesh]   VB " << r.vertexBytesBefore / 1024 << " -> " << r.vertexBytesAfter / 1024
+              << " KiB, IB " << r.indexBytesBefore / 1024 << " -> " << r.indexBytesAfter / 1024
+              << " KiB\n";
+}
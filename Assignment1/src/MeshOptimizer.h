@@ -0,0 +1,61 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "MeshData.h"
+
+// Import-time mesh optimisation, run once when a mesh cache is rebuilt:
+// weld, post-transform cache order (Forsyth), overdraw-aware cluster
+// order, then vertex fetch order.
+
+// Post-transform cache efficiency under a FIFO cache model.
+// ACMR: vertex shader runs per triangle (0.5 is the ideal for big grids).
+// ATVR: vertex shader runs per unique vertex (1.0 is ideal).
+struct VertexCacheStats {
+    float acmr = 0.0f;
+    float atvr = 0.0f;
+};
+
+VertexCacheStats analyzeVertexCache(const std::uint32_t* indices, std::size_t indexCount,
+    std::size_t vertexCount, unsigned cacheSize = 16);
+
+// Merges vertices with identical attributes and drops triangles that
+// collapsed as a result; returns the number of vertices removed
+std::size_t weldVertices(MeshData& mesh);
+
+// Tom Forsyth's linear-speed vertex cache optimisation
+void optimizeVertexCache(std::vector<std::uint32_t>& indices, std::size_t vertexCount);
+
+// Splits a cache-ordered index list where the cache restarts anyway and
+// sorts those clusters outward-facing first, so front-most surfaces tend
+// to be drawn before what they hide. Each cluster keeps its triangles and
+// their order; only the cluster order changes, so ACMR stays close to (not
+// exactly at) the pre-reorder value.
+void optimizeOverdraw(std::vector<std::uint32_t>& indices,
+    const std::vector<MeshVertex>& vertices, unsigned cacheSize = 16);
+
+// Renumbers vertices in order of first use by the index list
+void optimizeVertexFetch(MeshData& mesh);
+
+// Bytes per index needed to address vertexCount vertices: 2 or 4
+std::uint32_t indexSizeFor(std::size_t vertexCount);
+
+struct MeshOptimizeReport {
+    std::size_t verticesBefore = 0, verticesAfter = 0;
+    std::size_t trianglesBefore = 0, trianglesAfter = 0;
+    VertexCacheStats cacheBefore, cacheAfter;
+    std::size_t vertexBytesBefore = 0, vertexBytesAfter = 0;
+    std::size_t indexBytesBefore = 0, indexBytesAfter = 0;
+};
+
+// All of the above in order
+MeshOptimizeReport optimizeMesh(MeshData& mesh);
+void printReport(const MeshOptimizeReport& report, const char* name);
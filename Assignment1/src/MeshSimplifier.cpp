@@ -0,0 +1,292 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#include "MeshSimplifier.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <queue>
+#include <unordered_map>
+
+#include "FileUtils.h"
+#include "MeshOptimizer.h"
+
+namespace {
+
+// Symmetric 4x4 error quadric plus the total area that went into it, so
+// the error can be reported as an RMS distance
+struct Quadric {
+    double a2 = 0, ab = 0, ac = 0, ad = 0;
+    double b2 = 0, bc = 0, bd = 0;
+    double c2 = 0, cd = 0;
+    double d2 = 0;
+    double weight = 0;
+
+    static Quadric plane(const glm::dvec3& n, double d, double w) {
+        Quadric q;
+        q.a2 = n.x * n.x * w; q.ab = n.x * n.y * w; q.ac = n.x * n.z * w; q.ad = n.x * d * w;
+        q.b2 = n.y * n.y * w; q.bc = n.y * n.z * w; q.bd = n.y * d * w;
+        q.c2 = n.z * n.z * w; q.cd = n.z * d * w;
+        q.d2 = d * d * w;
+        q.weight = w;
+        return q;
+    }
+
+    Quadric& operator+=(const Quadric& o) {
+        a2 += o.a2; ab += o.ab; ac += o.ac; ad += o.ad;
+        b2 += o.b2; bc += o.bc; bd += o.bd;
+        c2 += o.c2; cd += o.cd;
+        d2 += o.d2;
+        weight += o.weight;
+        return *this;
+    }
+
+    // Weighted sum of squared distances from p to the planes
+    double evaluate(const glm::dvec3& p) const {
+        double x = p.x, y = p.y, z = p.z;
+        double r = a2 * x * x + 2 * ab * x * y + 2 * ac * x * z + 2 * ad * x
+                 + b2 * y * y + 2 * bc * y * z + 2 * bd * y
+                 + c2 * z * z + 2 * cd * z
+                 + d2;
+        return std::max(r, 0.0);
+    }
+};
+
+struct Collapse {
+    float cost;         // RMS distance
+    std::uint32_t from; // position class that moves
+    std::uint32_t to;   // position class it moves onto
+    std::uint32_t stampFrom, stampTo;
+
+    bool operator<(const Collapse& o) const { return cost > o.cost; } // min-heap
+};
+
+struct PositionHash {
+    std::size_t operator()(const glm::vec3& p) const {
+        return (std::size_t)hashBytes(&p, sizeof(p));
+    }
+};
+
+struct PositionEqual {
+    bool operator()(const glm::vec3& a, const glm::vec3& b) const {
+        return std::memcmp(&a, &b, sizeof(glm::vec3)) == 0;
+    }
+};
+
+// Border edges get a plane through the edge, perpendicular to the face,
+// weighted up so open boundaries keep their outline
+const double BorderWeight = 10.0;
+
+} // namespace
+
+float simplifyMesh(const std::vector<MeshVertex>& vertices,
+    const std::vector<std::uint32_t>& indices, std::size_t targetTriangles,
+    float maxError, std::vector<std::uint32_t>& out) {
+    out.clear();
+    const std::size_t triangleCount = indices.size() / 3;
+    if (triangleCount <= targetTriangles) {
+        out = indices;
+        return 0.0f;
+    }
+
+    // -------------------- Position classes --------------------
+    std::unordered_map<glm::vec3, std::uint32_t, PositionHash, PositionEqual> lookup;
+    lookup.reserve(vertices.size());
+    std::vector<std::uint32_t> classOf(vertices.size());
+    std::vector<glm::dvec3> position;
+    for (std::size_t v = 0; v < vertices.size(); ++v) {
+        auto it = lookup.emplace(vertices[v].position, (std::uint32_t)position.size());
+        if (it.second) position.push_back(glm::dvec3(vertices[v].position));
+        classOf[v] = it.first->second;
+    }
+    const std::size_t classCount = position.size();
+
+    std::vector<std::vector<std::uint32_t>> classVertices(classCount);
+    for (std::size_t v = 0; v < vertices.size(); ++v) classVertices[classOf[v]].push_back((std::uint32_t)v);
+
+    // -------------------- Triangles and quadrics --------------------
+    std::vector<std::uint32_t> tri(triangleCount * 3);
+    for (std::size_t i = 0; i < tri.size(); ++i) tri[i] = classOf[indices[i]];
+
+    std::vector<char> triAlive(triangleCount, 1);
+    std::vector<std::vector<std::uint32_t>> classTris(classCount);
+    std::vector<Quadric> quadric(classCount);
+    std::unordered_map<std::uint64_t, std::uint32_t> edgeUse;
+    std::size_t alive = 0;
+
+    auto edgeKey = [](std::uint32_t a, std::uint32_t b) {
+        if (a > b) std::swap(a, b);
+        return ((std::uint64_t)a << 32) | b;
+    };
+
+    for (std::size_t t = 0; t < triangleCount; ++t) {
+        std::uint32_t* c = &tri[t * 3];
+        if (c[0] == c[1] || c[1] == c[2] || c[0] == c[2]) { triAlive[t] = 0; continue; }
+        alive++;
+
+        glm::dvec3 n = glm::cross(position[c[1]] - position[c[0]], position[c[2]] - position[c[0]]);
+        double area = glm::length(n) * 0.5;
+        if (area > 0.0) n /= area * 2.0;
+        Quadric q = Quadric::plane(n, -glm::dot(n, position[c[0]]), area);
+        for (int k = 0; k < 3; ++k) {
+            quadric[c[k]] += q;
+            classTris[c[k]].push_back((std::uint32_t)t);
+            edgeUse[edgeKey(c[k], c[(k + 1) % 3])]++;
+        }
+    }
+
+    for (std::size_t t = 0; t < triangleCount; ++t) {
+        if (!triAlive[t]) continue;
+        const std::uint32_t* c = &tri[t * 3];
+        glm::dvec3 faceNormal = glm::cross(position[c[1]] - position[c[0]], position[c[2]] - position[c[0]]);
+        for (int k = 0; k < 3; ++k) {
+            std::uint32_t a = c[k], b = c[(k + 1) % 3];
+            if (edgeUse[edgeKey(a, b)] != 1) continue;
+            glm::dvec3 edge = position[b] - position[a];
+            glm::dvec3 n = glm::cross(edge, faceNormal);
+            double len = glm::length(n);
+            if (len <= 0.0) continue;
+            n /= len;
+            Quadric q = Quadric::plane(n, -glm::dot(n, position[a]), glm::dot(edge, edge) * BorderWeight);
+            quadric[a] += q;
+            quadric[b] += q;
+        }
+    }
+
+    // -------------------- Collapse queue --------------------
+    std::vector<std::uint32_t> stamp(classCount, 0);
+    std::vector<std::uint32_t> mergedInto(classCount);
+    for (std::size_t c = 0; c < classCount; ++c) mergedInto[c] = (std::uint32_t)c;
+    std::priority_queue<Collapse> heap;
+
+    auto collapseCost = [&](std::uint32_t from, std::uint32_t to) {
+        Quadric q = quadric[from];
+        q += quadric[to];
+        return q.weight > 0.0 ? (float)std::sqrt(q.evaluate(position[to]) / q.weight) : 0.0f;
+    };
+    auto pushEdge = [&](std::uint32_t a, std::uint32_t b) {
+        float ab = collapseCost(a, b);
+        float ba = collapseCost(b, a);
+        if (ab <= ba) heap.push({ ab, a, b, stamp[a], stamp[b] });
+        else heap.push({ ba, b, a, stamp[b], stamp[a] });
+    };
+
+    for (const auto& e : edgeUse) pushEdge((std::uint32_t)(e.first >> 32), (std::uint32_t)e.first);
+
+    float lastError = 0.0f;
+    while (alive > targetTriangles && !heap.empty()) {
+        Collapse c = heap.top();
+        heap.pop();
+        if (stamp[c.from] != c.stampFrom || stamp[c.to] != c.stampTo) continue;
+        if (mergedInto[c.from] != c.from || mergedInto[c.to] != c.to) continue;
+        if (c.cost > maxError) break;
+
+        // Reject collapses that would flip a surviving triangle
+        bool flips = false;
+        for (std::uint32_t t : classTris[c.from]) {
+            if (!triAlive[t]) continue;
+            const std::uint32_t* v = &tri[t * 3];
+            if (v[0] == c.to || v[1] == c.to || v[2] == c.to) continue;
+            glm::dvec3 p[3], q[3];
+            for (int k = 0; k < 3; ++k) {
+                p[k] = position[v[k]];
+                q[k] = v[k] == c.from ? position[c.to] : p[k];
+            }
+            glm::dvec3 before = glm::cross(p[1] - p[0], p[2] - p[0]);
+            glm::dvec3 after = glm::cross(q[1] - q[0], q[2] - q[0]);
+            if (glm::dot(before, after) <= 0.0) { flips = true; break; }
+        }
+        if (flips) continue;
+
+        for (std::uint32_t t : classTris[c.from]) {
+            if (!triAlive[t]) continue;
+            std::uint32_t* v = &tri[t * 3];
+            if (v[0] == c.to || v[1] == c.to || v[2] == c.to) {
+                triAlive[t] = 0;
+                alive--;
+                continue;
+            }
+            for (int k = 0; k < 3; ++k)
+                if (v[k] == c.from) v[k] = c.to;
+            classTris[c.to].push_back(t);
+        }
+        classTris[c.from].clear();
+        quadric[c.to] += quadric[c.from];
+        mergedInto[c.from] = c.to;
+        stamp[c.from]++;
+        stamp[c.to]++;
+        lastError = std::max(lastError, c.cost);
+
+        // Drop dead triangles and requeue the edges around the survivor
+        std::vector<std::uint32_t>& around = classTris[c.to];
+        around.erase(std::remove_if(around.begin(), around.end(),
+            [&](std::uint32_t t) { return !triAlive[t]; }), around.end());
+        for (std::uint32_t t : around) {
+            const std::uint32_t* v = &tri[t * 3];
+            for (int k = 0; k < 3; ++k)
+                if (v[k] != c.to) pushEdge(c.to, v[k]);
+        }
+    }
+
+    // -------------------- Back to vertices --------------------
+    auto finalClass = [&](std::uint32_t c) {
+        while (mergedInto[c] != c) c = mergedInto[c];
+        return c;
+    };
+
+    // A vertex whose position moved takes the closest-matching vertex
+    // (normal and UV) at the destination, so seams stay seams
+    std::vector<std::uint32_t> remap(vertices.size());
+    for (std::size_t v = 0; v < vertices.size(); ++v) {
+        std::uint32_t c = finalClass(classOf[v]);
+        if (c == classOf[v]) { remap[v] = (std::uint32_t)v; continue; }
+
+        float best = 1e30f;
+        for (std::uint32_t u : classVertices[c]) {
+            glm::vec3 dn = vertices[u].normal - vertices[v].normal;
+            glm::vec2 duv = vertices[u].texUV - vertices[v].texUV;
+            float d = glm::dot(dn, dn) + glm::dot(duv, duv);
+            if (d < best) { best = d; remap[v] = u; }
+        }
+    }
+
+    out.reserve(alive * 3);
+    for (std::size_t t = 0; t < triangleCount; ++t) {
+        if (!triAlive[t]) continue;
+        for (int k = 0; k < 3; ++k) out.push_back(remap[indices[t * 3 + k]]);
+    }
+    return lastError;
+}
+
+void buildLodChain(MeshData& mesh, int levels, float maxRelativeError) {
+    mesh.lods.clear();
+    if (mesh.indices.empty()) return;
+
+    MeshLod base;
+    base.indexCount = (std::uint32_t)mesh.indices.size();
+    mesh.lods.push_back(base);
+
+    // Each level simplifies the full-detail mesh, not the previous level,
+    // so errors do not compound
+    const std::vector<std::uint32_t> source = mesh.indices;
+    float maxError = maxRelativeError * boundingSphere(MeshView(mesh)).w;
+
+    std::vector<std::uint32_t> lod;
+    for (int level = 1; level < levels; ++level) {
+        std::size_t previous = mesh.lods.back().indexCount / 3;
+        float error = simplifyMesh(mesh.vertices, source, previous / 2, maxError, lod);
+        if (lod.empty() || lod.size() / 3 > previous * 4 / 5) break;
+
+        optimizeVertexCache(lod, mesh.vertices.size());
+        MeshLod entry;
+        entry.indexOffset = (std::uint32_t)mesh.indices.size();
+        entry.indexCount = (std::uint32_t)lod.size();
+        entry.error = error;
+        mesh.indices.insert(mesh.indices.end(), lod.begin(), lod.end());
+        mesh.lods.push_back(entry);
+    }
+}
@@ -0,0 +1,31 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "MeshData.h"
+
+// Quadric error metric (Garland-Heckbert) simplifier. Collapses edges
+// between vertex positions, so attribute seams (same position, different
+// normal/UV) move together, and always onto an existing vertex: the
+// result is a new index list over the unchanged vertex array, which lets
+// every LOD share one vertex buffer.
+//
+// Stops at targetTriangles or when the next collapse would move the
+// surface further than maxError (object-space units), whichever first.
+// Returns the error of the last collapse performed.
+float simplifyMesh(const std::vector<MeshVertex>& vertices,
+    const std::vector<std::uint32_t>& indices, std::size_t targetTriangles,
+    float maxError, std::vector<std::uint32_t>& out);
+
+// Appends up to levels-1 coarser LODs (each half the triangles of the
+// previous) to mesh.indices and fills mesh.lods; LOD 0 is the existing
+// index list. The chain stops at the first level that fails to reduce by
+// at least 20%.
+void buildLodChain(MeshData& mesh, int levels = 4, float maxRelativeError = 0.05f);
@@ -0,0 +1,26 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#pragma once
+
+#include <glad/glad.h>
+
+// Colour + depth framebuffer the benchmark renders into instead of the
+// window's back buffer, so nothing depends on a visible surface
+class OffscreenTarget {
+public:
+    bool create(int width, int height);
+    void bind() const;
+    static void unbind();
+    void Delete();
+
+private:
+    GLuint fbo = 0;
+    GLuint color = 0;
+    GLuint depth = 0;
+    int width = 0;
+    int height = 0;
+};
@@ -0,0 +1,279 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#include "Profiler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <imgui.h>
+
+namespace {
+
+float elapsedMs(std::chrono::steady_clock::time_point from,
+    std::chrono::steady_clock::time_point to) {
+    return std::chrono::duration<float, std::milli>(to - from).count();
+}
+
+// p in [0, 1]; nearest-rank on a copy
+float percentile(std::vector<float> values, float p) {
+    if (values.empty()) return 0.0f;
+    size_t k = std::min(values.size() - 1, (size_t)(p * (float)(values.size() - 1) + 0.5f));
+    std::nth_element(values.begin(), values.begin() + k, values.end());
+    return values[k];
+}
+
+// Empty field for a missing sample
+void writeField(std::ostream& out, float value) {
+    out << ',';
+    if (!std::isnan(value)) out << value;
+}
+
+} // namespace
+
+// -------------------- Frame --------------------
+
+void Profiler::beginFrame() {
+    frameStart = Clock::now();
+    frameStarted = true;
+}
+
+void Profiler::endFrame() {
+    if (!frameStarted) return;
+
+    // Close anything left open so one bad frame does not poison the rest
+    while (!open.empty()) endScope();
+
+    int slot = frameCount % HistorySize;
+    frameHistory[slot] = elapsedMs(frameStart, Clock::now());
+    if (capturing) {
+        captured.emplace_back();
+        captured.back().frameMs = frameHistory[slot];
+    }
+
+    for (Scope& scope : scopes) {
+        float ms = 0.0f;
+        scope.gpuFresh = scope.timerCreated && scope.timer.latestMs(ms);
+        if (scope.gpuFresh) scope.gpuLatest = ms;
+
+        scope.cpuHistory[slot] = scope.cpuThisFrame;
+        scope.gpuHistory[slot] = scope.gpuFresh ? std::max(ms, 0.0f) : NoSample;
+        scope.cpuThisFrame = 0.0f;
+        if (capturing) {
+            captured.back().scopes.push_back(scope.cpuHistory[slot]);
+            captured.back().scopes.push_back(scope.gpuHistory[slot]);
+        }
+    }
+    for (Counter& counter : counters) {
+        counter.history[slot] = (float)counter.thisFrame;
+        counter.thisFrame = 0.0;
+        if (capturing) captured.back().counters.push_back(counter.history[slot]);
+    }
+
+    frameCount++;
+    frameStarted = false;
+}
+
+// -------------------- Scopes --------------------
+
+int Profiler::findOrAddScope(const char* name, int depth) {
+    for (size_t i = 0; i < scopes.size(); ++i)
+        if (scopes[i].name == name) return (int)i;
+
+    Scope scope;
+    scope.name = name;
+    scope.depth = depth;
+    scopes.push_back(std::move(scope));
+    return (int)scopes.size() - 1;
+}
+
+void Profiler::beginScope(const char* name, int flags) {
+    int index = findOrAddScope(name, (int)open.size());
+    Scope& scope = scopes[index];
+    open.push_back(index);
+
+    if ((flags & Gpu) && openGpuScope < 0) {
+        if (!scope.timerCreated) {
+            scope.timer.create();
+            scope.timerCreated = true;
+        }
+        scope.gpu = true;
+        scope.timer.begin();
+        openGpuScope = index;
+    }
+
+    scope.start = Clock::now();
+}
+
+void Profiler::endScope() {
+    if (open.empty()) return;
+
+    int index = open.back();
+    open.pop_back();
+    Scope& scope = scopes[index];
+    scope.cpuThisFrame += elapsedMs(scope.start, Clock::now());
+
+    if (openGpuScope == index) {
+        scope.timer.end();
+        openGpuScope = -1;
+    }
+}
+
+bool Profiler::gpuMs(const char* name, float& ms) const {
+    for (const Scope& scope : scopes) {
+        if (scope.name != name) continue;
+        if (!scope.gpuFresh) return false;
+        ms = scope.gpuLatest;
+        return true;
+    }
+    return false;
+}
+
+void Profiler::setCounter(const char* name, double value) {
+    for (Counter& counter : counters) {
+        if (counter.name != name) continue;
+        counter.thisFrame = value;
+        return;
+    }
+    Counter counter;
+    counter.name = name;
+    counter.thisFrame = value;
+    counters.push_back(std::move(counter));
+}
+
+void Profiler::captureAll() {
+    if (capturing) return;
+    capturing = true;
+    captureStart = frameCount;
+}
+
+// -------------------- Output --------------------
+
+int Profiler::historyLength() const {
+    return std::min(frameCount, HistorySize);
+}
+
+int Profiler::oldestSlot() const {
+    return frameCount < HistorySize ? 0 : frameCount % HistorySize;
+}
+
+void Profiler::drawGUI() {
+    ImGui::Begin("Profiler");
+
+    int count = historyLength();
+    std::vector<float> frames(frameHistory.begin(), frameHistory.begin() + count);
+    float p50 = percentile(frames, 0.50f);
+    float p95 = percentile(frames, 0.95f);
+    float p99 = percentile(frames, 0.99f);
+
+    char overlay[64];
+    std::snprintf(overlay, sizeof(overlay), "p99 %.2f ms", p99);
+    ImGui::PlotLines("Frame ms", frameHistory.data(), count, oldestSlot(), overlay,
+        0.0f, std::max(p99 * 1.5f, 1.0f), ImVec2(0, 80));
+    ImGui::Text("p50 %.2f  p95 %.2f  p99 %.2f ms (%d frames)", p50, p95, p99, count);
+    ImGui::Separator();
+
+    // Mean over the history window, CPU and (lagged) GPU; the GPU mean is
+    // over the frames that have a sample
+    for (const Scope& scope : scopes) {
+        float cpu = 0.0f, gpu = 0.0f;
+        int gpuSamples = 0;
+        for (int i = 0; i < count; ++i) {
+            cpu += scope.cpuHistory[i];
+            if (std::isnan(scope.gpuHistory[i])) continue;
+            gpu += scope.gpuHistory[i];
+            ++gpuSamples;
+        }
+        if (count > 0) cpu /= count;
+        if (gpuSamples > 0) gpu /= gpuSamples;
+
+        if (scope.depth > 0) ImGui::Indent(12.0f * scope.depth);
+        if (scope.gpu && gpuSamples > 0)
+            ImGui::Text("%-14s cpu %6.3f  gpu %6.3f ms", scope.name.c_str(), cpu, gpu);
+        else if (scope.gpu)
+            ImGui::Text("%-14s cpu %6.3f  gpu    n/a", scope.name.c_str(), cpu);
+        else
+            ImGui::Text("%-14s cpu %6.3f ms", scope.name.c_str(), cpu);
+        if (scope.depth > 0) ImGui::Unindent(12.0f * scope.depth);
+    }
+
+    // Mean per frame over the same window
+    if (!counters.empty()) ImGui::Separator();
+    for (const Counter& counter : counters) {
+        float mean = 0.0f;
+        for (int i = 0; i < count; ++i) mean += counter.history[i];
+        if (count > 0) mean /= count;
+        ImGui::Text("%-22s %10.1f", counter.name.c_str(), mean);
+    }
+
+    ImGui::Separator();
+    if (ImGui::Button("Export CSV")) {
+        std::string path = "profile_" + std::to_string(exportCount++) + ".csv";
+        exportStatus = exportCsv(path) ? "Wrote " + path : "Failed to write " + path;
+    }
+    if (!exportStatus.empty()) {
+        ImGui::SameLine();
+        ImGui::Text("%s", exportStatus.c_str());
+    }
+
+    ImGui::End();
+}
+
+bool Profiler::exportCsv(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out) return false;
+
+    out << "frame,frame_ms";
+    for (const Scope& scope : scopes) {
+        out << ',' << scope.name << "_cpu_ms";
+        if (scope.gpu) out << ',' << scope.name << "_gpu_ms";
+    }
+    for (const Counter& counter : counters) out << ',' << counter.name;
+    out << '\n';
+
+    // Columns a frame predates are written as 0 (CPU) or left empty (GPU)
+    if (capturing) {
+        for (std::size_t i = 0; i < captured.size(); ++i) {
+            const CapturedFrame& frame = captured[i];
+            out << (captureStart + (int)i) << ',' << frame.frameMs;
+            for (std::size_t s = 0; s < scopes.size(); ++s) {
+                out << ',' << (s * 2 < frame.scopes.size() ? frame.scopes[s * 2] : 0.0f);
+                if (scopes[s].gpu) writeField(out, s * 2 + 1 < frame.scopes.size() ? frame.scopes[s * 2 + 1] : NoSample);
+            }
+            for (std::size_t c = 0; c < counters.size(); ++c)
+                out << ',' << (c < frame.counters.size() ? frame.counters[c] : 0.0f);
+            out << '\n';
+        }
+        return (bool)out;
+    }
+
+    // Oldest to newest
+    int count = historyLength();
+    int first = frameCount - count;
+    for (int i = 0; i < count; ++i) {
+        int slot = (oldestSlot() + i) % HistorySize;
+        out << (first + i) << ',' << frameHistory[slot];
+        for (const Scope& scope : scopes) {
+            out << ',' << scope.cpuHistory[slot];
+            if (scope.gpu) writeField(out, scope.gpuHistory[slot]);
+        }
+        for (const Counter& counter : counters) out << ',' << counter.history[slot];
+        out << '\n';
+    }
+    return (bool)out;
+}
+
+void Profiler::Delete() {
+    for (Scope& scope : scopes)
+        if (scope.timerCreated) scope.timer.Delete();
+    scopes.clear();
+    counters.clear();
+    captured.clear();
+    capturing = false;
+    open.clear();
+    openGpuScope = -1;
+}
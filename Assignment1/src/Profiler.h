@@ -0,0 +1,120 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#pragma once
+
+#include <chrono>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "GpuTimer.h"
+
+// Frame profiler: nestable CPU scopes plus GL_TIME_ELAPSED timing for
+// top-level scopes that ask for it. Keeps a rolling history per scope
+// for the ImGui panel and CSV export.
+//
+// GPU results come back a frame late (see GpuTimer), so the GPU column of
+// frame N holds the timing of the same scope issued on frame N-1. A frame
+// where no result arrived has no GPU sample: it is left out of the means
+// and written as an empty CSV field.
+class Profiler {
+public:
+    static constexpr int HistorySize = 300;
+    static constexpr float NoSample = std::numeric_limits<float>::quiet_NaN();
+
+    enum ScopeFlags { CpuOnly = 0, Gpu = 1 };
+
+    void beginFrame();
+    void endFrame();
+
+    // Scopes nest on the CPU. GL_TIME_ELAPSED queries cannot, so Gpu is
+    // ignored for a scope opened inside another GPU-timed scope. Scopes
+    // are keyed by name: two with the same name share one history.
+    void beginScope(const char* name, int flags = CpuOnly);
+    void endScope();
+
+    // GPU time of a scope that came back during the last endFrame
+    // (i.e. the previous frame's timing); false if none arrived
+    bool gpuMs(const char* name, float& ms) const;
+
+    // Per-frame counter listed under the scopes and exported with them;
+    // a counter not set in a frame records 0
+    void setCounter(const char* name, double value);
+
+    // Keeps every frame from now on, not just the rolling history, and
+    // exportCsv writes all of them; a replay uses it to cover a whole run
+    void captureAll();
+
+    void drawGUI();
+    bool exportCsv(const std::string& path) const;
+    void Delete();
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Scope {
+        std::string name;
+        int depth = 0;
+        bool gpu = false;
+        bool timerCreated = false;
+        GpuTimer timer;
+        Clock::time_point start;
+        float cpuThisFrame = 0.0f;
+        float gpuLatest = -1.0f;
+        bool gpuFresh = false;
+        std::vector<float> cpuHistory = std::vector<float>(HistorySize, 0.0f);
+        // NaN marks a frame whose query had not come back (or predates the scope)
+        std::vector<float> gpuHistory = std::vector<float>(HistorySize, NoSample);
+    };
+
+    struct Counter {
+        std::string name;
+        double thisFrame = 0.0;
+        std::vector<float> history = std::vector<float>(HistorySize, 0.0f);
+    };
+
+    // One frame of a capture; cpu, gpu per scope and counters in the
+    // order they were first seen, so later frames only ever add columns
+    struct CapturedFrame {
+        float frameMs = 0.0f;
+        std::vector<float> scopes;
+        std::vector<float> counters;
+    };
+
+    int findOrAddScope(const char* name, int depth);
+    int historyLength() const;
+    int oldestSlot() const;
+
+    std::vector<Scope> scopes;
+    std::vector<Counter> counters;
+    std::vector<int> open;       // stack of open scope indices
+    int openGpuScope = -1;
+
+    Clock::time_point frameStart;
+    bool frameStarted = false;
+    std::vector<float> frameHistory = std::vector<float>(HistorySize, 0.0f);
+    int frameCount = 0;           // frames recorded so far
+    bool capturing = false;
+    int captureStart = 0;         // frame index of captured[0]
+    std::vector<CapturedFrame> captured;
+    int exportCount = 0;
+    std::string exportStatus;
+};
+
+// RAII helper for scopes inside functions
+class ProfileScope {
+public:
+    ProfileScope(Profiler& profiler, const char* name, int flags = Profiler::CpuOnly)
+        : profiler(profiler) { profiler.beginScope(name, flags); }
+    ~ProfileScope() { profiler.endScope(); }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    Profiler& profiler;
+};
@@ -0,0 +1,206 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#include "ProgramCache.h"
+
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include "FileUtils.h"
+
+namespace {
+
+struct ProgramCacheHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t binaryFormat;
+    std::uint64_t binarySize;
+    std::uint64_t sourceHash; // both stages, chained
+    std::uint64_t driverHash; // vendor, renderer and version strings
+};
+
+const char CacheMagic[8] = { 'R', 'T', 'A', 'P', 'R', 'O', 'G', '\0' };
+const std::uint32_t CacheVersion = 1;
+
+std::string fileName(const std::string& path) {
+    std::size_t slash = path.find_last_of("/\\");
+    return slash == std::string::npos ? path : path.substr(slash + 1);
+}
+
+bool readSource(const std::string& path, std::string& source) {
+    MappedFile file(path);
+    if (!file.isOpen()) return false;
+    source.assign(reinterpret_cast<const char*>(file.data()), file.size());
+    return true;
+}
+
+// Inserts #define name after the #version line, which must stay first
+void addDefine(std::string& source, const std::string& name) {
+    std::size_t lineEnd = source.find('\n');
+    std::size_t at = lineEnd == std::string::npos ? source.size() : lineEnd + 1;
+    if (lineEnd == std::string::npos) source += '\n';
+    source.insert(at, "#define " + name + "\n");
+}
+
+// A driver update invalidates every binary, so it is part of the key
+std::uint64_t driverHash() {
+    std::uint64_t hash = 14695981039346656037ull;
+    for (GLenum name : { GL_VENDOR, GL_RENDERER, GL_VERSION }) {
+        const char* str = (const char*)glGetString(name);
+        if (str) hash = hashBytes(str, std::strlen(str) + 1, hash);
+    }
+    return hash;
+}
+
+GLuint compileStage(GLenum type, const std::string& source, const std::string& path,
+    std::string& log) {
+    GLuint shader = glCreateShader(type);
+    const char* text = source.c_str();
+    glShaderSource(shader, 1, &text, nullptr);
+    glCompileShader(shader);
+
+    GLint ok = GL_FALSE;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &ok);
+    if (!ok) {
+        char info[1024];
+        glGetShaderInfoLog(shader, sizeof(info), nullptr, info);
+        log += path + ": " + info;
+        glDeleteShader(shader);
+        return 0;
+    }
+    return shader;
+}
+
+bool linked(GLuint program) {
+    GLint ok = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &ok);
+    return ok == GL_TRUE;
+}
+
+GLuint loadBinary(const std::string& path, std::uint64_t sourceHash, std::uint64_t driver) {
+    MappedFile file(path);
+    ProgramCacheHeader header;
+    if (!file.isOpen() || file.size() < sizeof(header)) return 0;
+    std::memcpy(&header, file.data(), sizeof(header));
+
+    bool valid = std::memcmp(header.magic, CacheMagic, sizeof(CacheMagic)) == 0 &&
+        header.version == CacheVersion &&
+        header.sourceHash == sourceHash &&
+        header.driverHash == driver &&
+        header.binarySize > 0 && header.binarySize <= file.size() - sizeof(header);
+    if (!valid) return 0;
+
+    // The driver may still refuse it (e.g. a different GPU with the same
+    // strings), which shows up as a failed link
+    GLuint program = glCreateProgram();
+    glProgramBinary(program, header.binaryFormat, file.data() + sizeof(header),
+        (GLsizei)header.binarySize);
+    if (!linked(program)) {
+        glDeleteProgram(program);
+        return 0;
+    }
+    return program;
+}
+
+void saveBinary(const std::string& path, GLuint program, std::uint64_t sourceHash,
+    std::uint64_t driver) {
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) return;
+
+    std::vector<unsigned char> bytes(sizeof(ProgramCacheHeader) + (std::size_t)length);
+    GLenum format = 0;
+    GLsizei written = 0;
+    glGetProgramBinary(program, length, &written, &format, bytes.data() + sizeof(ProgramCacheHeader));
+    if (written <= 0) return;
+
+    ProgramCacheHeader header = {};
+    std::memcpy(header.magic, CacheMagic, sizeof(CacheMagic));
+    header.version = CacheVersion;
+    header.binaryFormat = format;
+    header.binarySize = (std::uint64_t)written;
+    header.sourceHash = sourceHash;
+    header.driverHash = driver;
+    std::memcpy(bytes.data(), &header, sizeof(header));
+    bytes.resize(sizeof(header) + (std::size_t)written);
+    if (!writeFileAtomic(path, bytes.data(), bytes.size()))
+        std::cerr << "[Shader] Could not write " << path << std::endl;
+}
+
+} // namespace
+
+std::string ProgramCache::cachePath(const std::string& vertexPath, const std::string& fragmentPath,
+    const std::string& define) {
+    std::string variant = define.empty() ? "" : "." + define;
+    return vertexPath + "." + fileName(fragmentPath) + variant + ".progcache";
+}
+
+bool ProgramCache::supported() {
+    if (!glGetProgramBinary || !glProgramBinary) return false;
+    GLint formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    return formats > 0;
+}
+
+ProgramBuild ProgramCache::build(const std::string& vertexPath, const std::string& fragmentPath,
+    const std::string& define) {
+    ProgramBuild result;
+    std::string vertexSource, fragmentSource;
+    if (!readSource(vertexPath, vertexSource) || !readSource(fragmentPath, fragmentSource)) {
+        result.log = "cannot read " + vertexPath + " or " + fragmentPath;
+        return result;
+    }
+    // The hash below covers the define too
+    if (!define.empty()) {
+        addDefine(vertexSource, define);
+        addDefine(fragmentSource, define);
+    }
+
+    const bool binaries = supported();
+    const std::string path = cachePath(vertexPath, fragmentPath, define);
+    const std::uint64_t sourceHash = hashBytes(fragmentSource.data(), fragmentSource.size(),
+        hashBytes(vertexSource.data(), vertexSource.size()));
+    const std::uint64_t driver = binaries ? driverHash() : 0;
+
+    if (binaries) {
+        result.program = loadBinary(path, sourceHash, driver);
+        result.cached = result.program != 0;
+        if (result.cached) return result;
+    }
+
+    // From source
+    GLuint vs = compileStage(GL_VERTEX_SHADER, vertexSource, vertexPath, result.log);
+    GLuint fs = compileStage(GL_FRAGMENT_SHADER, fragmentSource, fragmentPath, result.log);
+    if (!vs || !fs) {
+        if (vs) glDeleteShader(vs);
+        if (fs) glDeleteShader(fs);
+        return result;
+    }
+
+    GLuint program = glCreateProgram();
+    glAttachShader(program, vs);
+    glAttachShader(program, fs);
+    if (binaries) glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    glLinkProgram(program);
+    glDetachShader(program, vs);
+    glDetachShader(program, fs);
+    glDeleteShader(vs);
+    glDeleteShader(fs);
+
+    if (!linked(program)) {
+        char info[1024];
+        glGetProgramInfoLog(program, sizeof(info), nullptr, info);
+        result.log += vertexPath + " + " + fragmentPath + ": " + info;
+        glDeleteProgram(program);
+        return result;
+    }
+
+    if (binaries) saveBinary(path, program, sourceHash, driver);
+    result.program = program;
+    return result;
+}
@@ -0,0 +1,37 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#pragma once
+
+#include <string>
+#include <glad/glad.h>
+
+// Outcome of building one vertex + fragment program
+struct ProgramBuild {
+    GLuint program = 0; // 0 if the sources did not compile or link
+    bool cached = false; // linked from the binary cache
+    std::string log;     // compile / link errors
+};
+
+// Persistent cache of linked programs. The glGetProgramBinary blob is
+// stored in <vertex>.<fragment file>[.<define>].progcache, keyed by the
+// hash of both sources and of the driver's vendor, renderer and version
+// strings, so warm starts skip compiling and linking. A stale or rejected
+// binary falls back to the sources and the cache is rewritten.
+namespace ProgramCache {
+    std::string cachePath(const std::string& vertexPath, const std::string& fragmentPath,
+        const std::string& define = "");
+
+    // Program binaries need GL 4.1 or ARB_get_program_binary and at least
+    // one binary format; asks the current context
+    bool supported();
+
+    // Builds on the current context, which may be a shared worker context.
+    // A define is added to both stages after their #version line, making a
+    // variant of the program that is cached apart from the plain one.
+    ProgramBuild build(const std::string& vertexPath, const std::string& fragmentPath,
+        const std::string& define = "");
+}
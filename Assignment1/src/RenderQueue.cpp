@@ -0,0 +1,101 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#include "RenderQueue.h"
+
+#include <algorithm>
+#include <cstring>
+
+int RenderQueue::addMaterial(const std::vector<GLuint>& textures) {
+    materials.push_back(textures);
+    return (int)materials.size() - 1;
+}
+
+void RenderQueue::clear() {
+    items.clear();
+    entries.clear();
+    programs.clear();
+    vertexArrays.clear();
+}
+
+// A handful of programs and VAOs per frame, so a linear scan beats a map.
+// Past the limit everything shares the last rank: still correct, just
+// grouped less well.
+std::uint32_t RenderQueue::rank(std::vector<GLuint>& seen, GLuint name, int limit) {
+    for (std::size_t i = 0; i < seen.size(); ++i)
+        if (seen[i] == name) return (std::uint32_t)std::min(i, (std::size_t)limit - 1);
+    seen.push_back(name);
+    return (std::uint32_t)std::min(seen.size() - 1, (std::size_t)limit - 1);
+}
+
+void RenderQueue::submit(const DrawItem& item, float depth) {
+    // Non-negative floats order the same as their bit patterns
+    float clamped = std::max(depth, 0.0f);
+    std::uint32_t depthBits;
+    std::memcpy(&depthBits, &clamped, sizeof(depthBits));
+    std::uint32_t material = (std::uint32_t)std::clamp(item.material + 1, 0, MaxMaterials - 1);
+
+    std::uint64_t key = (std::uint64_t)rank(programs, item.program, MaxPrograms) << 56
+                      | (std::uint64_t)material << 44
+                      | (std::uint64_t)rank(vertexArrays, item.vao, MaxVertexArrays) << 32
+                      | depthBits;
+    entries.push_back({ key, (std::uint32_t)items.size() });
+    items.push_back(item);
+}
+
+void RenderQueue::sort() {
+    // LSD radix, a byte per pass. All eight histograms come from one read
+    // of the keys, and a pass whose byte is the same for every key is
+    // skipped; with few programs and materials most high passes are.
+    const std::size_t n = entries.size();
+    if (n < 2) return;
+    std::uint32_t counts[8][256] = {};
+    for (const Entry& entry : entries)
+        for (int pass = 0; pass < 8; ++pass) counts[pass][(entry.key >> (pass * 8)) & 0xff]++;
+
+    scratch.resize(n);
+    for (int pass = 0; pass < 8; ++pass) {
+        std::uint32_t* count = counts[pass];
+        const int shift = pass * 8;
+        if (count[(entries[0].key >> shift) & 0xff] == n) continue;
+
+        std::uint32_t offset = 0;
+        for (int b = 0; b < 256; ++b) {
+            std::uint32_t c = count[b];
+            count[b] = offset;
+            offset += c;
+        }
+        for (const Entry& entry : entries) scratch[count[(entry.key >> shift) & 0xff]++] = entry;
+        entries.swap(scratch);
+    }
+}
+
+void RenderQueue::execute(GlState& state) {
+    state.invalidate();
+    draws = 0;
+    triangles = 0;
+    for (const Entry& entry : entries) {
+        const DrawItem& item = items[entry.item];
+        state.useProgram(item.program);
+        if (item.material >= 0 && item.material < (int)materials.size()) {
+            const std::vector<GLuint>& textures = materials[item.material];
+            for (std::size_t unit = 0; unit < textures.size(); ++unit)
+                state.bindTexture((GLuint)unit, GL_TEXTURE_2D, textures[unit]);
+        }
+        state.bindVertexArray(item.vao);
+        if (item.prepare) item.prepare(item.owner, item.arg);
+
+        glDrawElementsInstanced(item.mode, item.count, item.indexType,
+            (void*)item.indexOffset, item.instances);
+        draws++;
+        if (item.mode == GL_TRIANGLES) triangles += (long long)(item.count / 3) * item.instances;
+    }
+
+    // Hand GL back the way the rest of the frame expects it
+    state.bindVertexArray(0);
+    glActiveTexture(GL_TEXTURE0);
+    state.invalidate();
+}
@@ -0,0 +1,82 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glad/glad.h>
+
+#include "GlState.h"
+
+// Per-draw setup run once the item's program, textures and VAO are bound,
+// e.g. attribute offsets or uniforms; arg is the item's own value
+using DrawPrepare = void (*)(const void* owner, std::uint32_t arg);
+
+// One indexed, instanced draw and the state it needs
+struct DrawItem {
+    GLuint program = 0;
+    GLuint vao = 0;
+    int material = -1;             // from RenderQueue::addMaterial; -1 binds none
+    GLenum mode = GL_TRIANGLES;
+    GLsizei count = 0;             // indices
+    GLenum indexType = GL_UNSIGNED_INT;
+    std::size_t indexOffset = 0;   // bytes
+    GLsizei instances = 1;
+    DrawPrepare prepare = nullptr;
+    const void* owner = nullptr;
+    std::uint32_t arg = 0;
+};
+
+// Draws for one frame, submitted in any order and issued sorted by a
+// 64-bit key through a GlState, so runs sharing a program, material or
+// VAO bind it once. Key, high bits first:
+//   program (8) | material (12) | VAO (12) | view depth (32)
+// State changes are the primary order; within a run opaque draws go front
+// to back. Programs and VAOs are ranked in the order they are first seen
+// each frame, so the key never depends on GL's object names.
+class RenderQueue {
+public:
+    static constexpr int MaxPrograms = 1 << 8;
+    static constexpr int MaxMaterials = 1 << 12;
+    static constexpr int MaxVertexArrays = 1 << 12;
+
+    // Texture set bound to units 0..n-1 (GL_TEXTURE_2D); returns its id.
+    // Materials live as long as the queue.
+    int addMaterial(const std::vector<GLuint>& textures);
+
+    void clear();
+    // depth: distance from the camera, for ordering only
+    void submit(const DrawItem& item, float depth);
+    // Radix sort on the keys; stable, so equal keys keep submission order
+    void sort();
+    // Issues the sorted items. The state is invalidated first, since
+    // anything may have been bound since the last call.
+    void execute(GlState& state);
+
+    std::size_t size() const { return items.size(); }
+    // Of the last execute()
+    int drawCalls() const { return draws; }
+    long long trianglesDrawn() const { return triangles; }
+
+private:
+    struct Entry {
+        std::uint64_t key;
+        std::uint32_t item;
+    };
+
+    static std::uint32_t rank(std::vector<GLuint>& seen, GLuint name, int limit);
+
+    std::vector<DrawItem> items;
+    std::vector<Entry> entries;
+    std::vector<Entry> scratch;
+    std::vector<std::vector<GLuint>> materials;
+    std::vector<GLuint> programs;     // this frame's, by rank
+    std::vector<GLuint> vertexArrays;
+    int draws = 0;
+    long long triangles = 0;
+};
@@ -0,0 +1,109 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#include "ShaderCompiler.h"
+
+#include <iostream>
+#include <utility>
+
+ShaderCompiler::ShaderCompiler(GLFWwindow* shareWith) {
+    if (!shareWith) return;
+
+    // Same context version, profile and creation API as the main window,
+    // or the driver may refuse to share
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, glfwGetWindowAttrib(shareWith, GLFW_CONTEXT_VERSION_MAJOR));
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, glfwGetWindowAttrib(shareWith, GLFW_CONTEXT_VERSION_MINOR));
+    glfwWindowHint(GLFW_OPENGL_PROFILE, glfwGetWindowAttrib(shareWith, GLFW_OPENGL_PROFILE));
+    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, glfwGetWindowAttrib(shareWith, GLFW_OPENGL_FORWARD_COMPAT));
+    glfwWindowHint(GLFW_CONTEXT_CREATION_API, glfwGetWindowAttrib(shareWith, GLFW_CONTEXT_CREATION_API));
+    context = glfwCreateWindow(1, 1, "Shader compiler", nullptr, shareWith);
+    // Hints are global: leave none behind for windows created later
+    glfwDefaultWindowHints();
+    if (!context) {
+        std::cout << "[Shader] No shared context, compiling on the main thread\n";
+        return;
+    }
+    worker = std::thread([this] { workerLoop(); });
+}
+
+void ShaderCompiler::Delete() {
+    if (worker.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        jobReady.notify_all();
+        worker.join();
+    }
+    if (context) {
+        glfwDestroyWindow(context);
+        context = nullptr;
+    }
+    // Programs nobody collected
+    for (const ShaderBuild& build : done)
+        if (build.result.program) glDeleteProgram(build.result.program);
+    done.clear();
+    queue.clear();
+}
+
+unsigned ShaderCompiler::submit(const std::string& vertexPath, const std::string& fragmentPath,
+    const std::string& define) {
+    ShaderBuild build;
+    build.vertexPath = vertexPath;
+    build.fragmentPath = fragmentPath;
+    build.define = define;
+    unsigned ticket;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ticket = build.ticket = nextTicket++;
+        queue.push_back(std::move(build));
+    }
+    jobReady.notify_one();
+    return ticket;
+}
+
+bool ShaderCompiler::take(unsigned ticket, ShaderBuild& out) {
+    if (!threaded()) {
+        // No worker: build whatever is queued right here
+        while (!queue.empty()) {
+            ShaderBuild build = std::move(queue.front());
+            queue.pop_front();
+            build.result = ProgramCache::build(build.vertexPath, build.fragmentPath, build.define);
+            done.push_back(std::move(build));
+        }
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto it = done.begin(); it != done.end(); ++it) {
+        if (it->ticket != ticket) continue;
+        out = std::move(*it);
+        done.erase(it);
+        return true;
+    }
+    return false;
+}
+
+void ShaderCompiler::workerLoop() {
+    glfwMakeContextCurrent(context);
+    for (;;) {
+        ShaderBuild build;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            jobReady.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (stopping) break;
+            build = std::move(queue.front());
+            queue.pop_front();
+        }
+
+        build.result = ProgramCache::build(build.vertexPath, build.fragmentPath, build.define);
+        // Complete on this context before the main one may use it
+        glFinish();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        done.push_back(std::move(build));
+    }
+    glfwMakeContextCurrent(nullptr);
+}
@@ -0,0 +1,68 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <GLFW/glfw3.h>
+
+#include "ProgramCache.h"
+
+// A program build handed back by ShaderCompiler
+struct ShaderBuild {
+    unsigned ticket = 0;
+    std::string vertexPath;
+    std::string fragmentPath;
+    std::string define; // empty for the plain program
+    ProgramBuild result;
+};
+
+// Builds programs (through ProgramCache) on a worker thread that owns a
+// hidden context sharing objects with the main window, so compiling never
+// stalls a frame. Programs are shared between the contexts, and the worker
+// finishes each one before handing it over. If no shared context can be
+// made, builds run on the main thread inside take() instead.
+class ShaderCompiler {
+public:
+    // Call on the main thread after the window's context is set up
+    explicit ShaderCompiler(GLFWwindow* shareWith);
+    ~ShaderCompiler() { Delete(); }
+
+    ShaderCompiler(const ShaderCompiler&) = delete;
+    ShaderCompiler& operator=(const ShaderCompiler&) = delete;
+
+    bool threaded() const { return context != nullptr; }
+
+    // Queues a build and returns its ticket; define selects a variant, see
+    // ProgramCache::build
+    unsigned submit(const std::string& vertexPath, const std::string& fragmentPath,
+        const std::string& define = "");
+    // Hands over the build for ticket once it has finished; main thread
+    // only. Each client collects just the tickets it submitted, so builds
+    // meant for someone else stay queued for them.
+    bool take(unsigned ticket, ShaderBuild& out);
+
+    // Stops the worker and destroys its context; main thread, before the
+    // window goes
+    void Delete();
+
+private:
+    void workerLoop();
+
+    GLFWwindow* context = nullptr;
+    std::thread worker;
+    std::deque<ShaderBuild> queue;
+    std::vector<ShaderBuild> done;
+    std::mutex mutex;
+    std::condition_variable jobReady;
+    unsigned nextTicket = 1;
+    bool stopping = false;
+};
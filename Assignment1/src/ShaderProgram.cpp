@@ -0,0 +1,32 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#include "ShaderProgram.h"
+
+void ShaderProgram::adopt(GLuint program) {
+    if (ID && ID != program) glDeleteProgram(ID);
+    ID = program;
+}
+
+void ShaderProgram::Delete() {
+    if (ID) glDeleteProgram(ID);
+    ID = 0;
+}
+
+Shader& EngineShaderView::operator()(const ShaderProgram& program) {
+    if (!shader) {
+        shader = std::make_unique<Shader>("Shaders/shell.vert", "Shaders/shell.frag");
+        shader->Delete();
+    }
+    shader->ID = program.ID;
+    return *shader;
+}
+
+void EngineShaderView::Delete() {
+    // Whatever the engine Shader does when destroyed, it holds no program
+    if (shader) shader->ID = 0;
+    shader.reset();
+}
@@ -0,0 +1,43 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#pragma once
+
+#include <memory>
+#include <glad/glad.h>
+#include <engine/Shader.h>
+
+// A linked program handed over by ShaderCompiler (or a hot reload). The
+// engine Shader can only be built by compiling files itself, so programs
+// linked elsewhere live here. Not copyable: exactly one owner deletes it.
+class ShaderProgram {
+public:
+    ShaderProgram() = default;
+    ShaderProgram(const ShaderProgram&) = delete;
+    ShaderProgram& operator=(const ShaderProgram&) = delete;
+
+    GLuint ID = 0; // 0 until a program has been adopted
+
+    bool ready() const { return ID != 0; }
+    void Activate() const { glUseProgram(ID); }
+    // Takes ownership of program, deleting the one held before
+    void adopt(GLuint program);
+    void Delete();
+};
+
+// Model::Draw and Skybox::Draw take an engine Shader. This is one, built
+// from the Shaders/shell stubs the first time an engine object draws
+// (after loading, not at startup) and pointed at the program of each call.
+// It never owns a program, so nothing is deleted twice.
+class EngineShaderView {
+public:
+    Shader& operator()(const ShaderProgram& program);
+    // Main thread, while the context is still current
+    void Delete();
+
+private:
+    std::unique_ptr<Shader> shader;
+};
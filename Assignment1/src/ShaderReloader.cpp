@@ -0,0 +1,56 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#include "ShaderReloader.h"
+
+#include <iostream>
+#include <utility>
+
+#include "FileUtils.h"
+
+void ShaderReloader::watch(ShaderProgram& program, const std::string& vertexPath,
+    const std::string& fragmentPath, std::function<void()> onReload, const std::string& define) {
+    Entry entry;
+    entry.program = &program;
+    entry.vertexPath = vertexPath;
+    entry.fragmentPath = fragmentPath;
+    entry.define = define;
+    entry.vertexTime = fileModifiedTime(vertexPath);
+    entry.fragmentTime = fileModifiedTime(fragmentPath);
+    entry.onReload = std::move(onReload);
+    entries.push_back(std::move(entry));
+}
+
+void ShaderReloader::update(float now) {
+    // A few stat calls, twice a second
+    if (now - lastCheck >= interval) {
+        lastCheck = now;
+        for (Entry& entry : entries) {
+            if (entry.ticket) continue;
+            long long vertexTime = fileModifiedTime(entry.vertexPath);
+            long long fragmentTime = fileModifiedTime(entry.fragmentPath);
+            if (vertexTime == entry.vertexTime && fragmentTime == entry.fragmentTime) continue;
+            entry.vertexTime = vertexTime;
+            entry.fragmentTime = fragmentTime;
+            entry.ticket = compiler.submit(entry.vertexPath, entry.fragmentPath, entry.define);
+        }
+    }
+
+    ShaderBuild build;
+    for (Entry& entry : entries) {
+        if (!entry.ticket || !compiler.take(entry.ticket, build)) continue;
+        entry.ticket = 0;
+        if (!build.result.program) {
+            std::cerr << "[Shader] Reload failed, keeping the last good program:\n"
+                      << build.result.log << std::endl;
+            continue;
+        }
+        entry.program->adopt(build.result.program);
+        entry.onReload();
+        ++reloadCount;
+        std::cout << "[Shader] Reloaded " << entry.vertexPath << " + " << entry.fragmentPath << "\n";
+    }
+}
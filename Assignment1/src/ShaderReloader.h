@@ -0,0 +1,52 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+#include "ShaderCompiler.h"
+#include "ShaderProgram.h"
+
+// Hot reload: polls the modification times of each watched program's
+// sources and rebuilds it through the ShaderCompiler when one changes.
+// The old program keeps drawing until the new one has linked, so an edit
+// never stalls a frame and a broken edit leaves the last good program.
+class ShaderReloader {
+public:
+    explicit ShaderReloader(ShaderCompiler& compiler, float checkInterval = 0.5f)
+        : compiler(compiler), interval(checkInterval) {}
+
+    // onReload runs on the main thread right after program.ID changes;
+    // anything resolved from the old program (uniforms, blocks) is redone
+    // there. define rebuilds the same variant the program was built as.
+    void watch(ShaderProgram& program, const std::string& vertexPath, const std::string& fragmentPath,
+        std::function<void()> onReload, const std::string& define = "");
+
+    // Call once per frame on the main thread; now is in seconds
+    void update(float now);
+
+    int reloads() const { return reloadCount; }
+
+private:
+    struct Entry {
+        ShaderProgram* program;
+        std::string vertexPath;
+        std::string fragmentPath;
+        std::string define;
+        long long vertexTime;
+        long long fragmentTime;
+        std::function<void()> onReload;
+        unsigned ticket = 0; // build in flight, 0 if none
+    };
+
+    ShaderCompiler& compiler;
+    std::vector<Entry> entries;
+    float interval;
+    float lastCheck = 0.0f;
+    int reloadCount = 0;
+};
@@ -0,0 +1,14 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#pragma once
+
+// SSE2 is the x86-64 baseline, so it is used without a runtime check.
+// Wider paths (AVX2) live in their own translation units and are chosen
+// at runtime; see BatchMath.h.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RTA_SSE 1
+#endif
@@ -0,0 +1,149 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#include "StreamBuffer.h"
+
+#include <algorithm>
+#include <iostream>
+
+namespace {
+
+std::size_t alignUp(std::size_t value, std::size_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+// Blocks until the fence passes; true if it had not already
+bool waitFence(GLsync& fence) {
+    if (!fence) return false;
+    bool stalled = false;
+    GLenum result = glClientWaitSync(fence, 0, 0);
+    while (result == GL_TIMEOUT_EXPIRED) {
+        stalled = true;
+        result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000); // 1 ms
+    }
+    glDeleteSync(fence);
+    fence = nullptr;
+    return stalled;
+}
+
+} // namespace
+
+void StreamBuffer::create(std::size_t bytesPerFrame) {
+    GLint alignment = 0;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    if (alignment > 0) uniformAlignment = (std::size_t)alignment;
+    if (GLAD_GL_VERSION_4_3) {
+        glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &alignment);
+        if (alignment > 0) storageAlignment = (std::size_t)alignment;
+    }
+    region = alignUp(bytesPerFrame, 256);
+    allocateStorage();
+}
+
+void StreamBuffer::allocateStorage() {
+    glGenBuffers(1, &buffer);
+    // A target no VAO records, so creating this never disturbs one
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+    const GLsizeiptr total = (GLsizeiptr)(region * Regions);
+    if (GLAD_GL_VERSION_4_4 || GLAD_GL_ARB_buffer_storage) {
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_COPY_WRITE_BUFFER, total, nullptr, flags);
+        mapped = static_cast<unsigned char*>(glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, total, flags));
+        if (!mapped) {
+            // Immutable storage cannot be respecified: start over with a
+            // fresh buffer for the mutable path
+            std::cout << "[Stream] Persistent mapping failed, mapping per allocation\n";
+            glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+            glDeleteBuffers(1, &buffer);
+            glGenBuffers(1, &buffer);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+        }
+    }
+    if (!mapped) glBufferData(GL_COPY_WRITE_BUFFER, total, nullptr, GL_STREAM_DRAW);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    current = 0;
+    head = 0;
+}
+
+void StreamBuffer::releaseStorage() {
+    for (GLsync& fence : fences) waitFence(fence);
+    if (mapped) {
+        glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+        glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        mapped = nullptr;
+    }
+    if (buffer) glDeleteBuffers(1, &buffer);
+    buffer = 0;
+}
+
+void StreamBuffer::Delete() {
+    releaseStorage();
+}
+
+void StreamBuffer::beginFrame() {
+    if (!buffer) return;
+    if (overflowed) {
+        // Every region is replaced, so wait for all of them; rare, and
+        // only while the working set is still growing
+        std::size_t grown = std::max(region * 2, alignUp(requested + requested / 2, 256));
+        std::cout << "[Stream] Growing frame regions to " << (grown >> 10) << " KB\n";
+        releaseStorage();
+        region = grown;
+        allocateStorage();
+        overflowed = false;
+    }
+    stalledLast = waitFence(fences[current]);
+    head = 0;
+    requested = 0;
+}
+
+StreamAllocation StreamBuffer::allocate(std::size_t bytes, std::size_t alignment) {
+    StreamAllocation allocation;
+    std::size_t start = alignUp(head, alignment);
+    requested = alignUp(requested, alignment) + bytes;
+    if (!buffer || bytes == 0 || start + bytes > region) {
+        overflowed = overflowed || bytes > 0;
+        return allocation;
+    }
+
+    allocation.buffer = buffer;
+    allocation.offset = (GLintptr)(region * current + start);
+    allocation.size = bytes;
+    if (mapped) {
+        allocation.data = mapped + allocation.offset;
+    } else {
+        // The region's fence has passed, so nothing can be reading it
+        glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+        allocation.data = glMapBufferRange(GL_COPY_WRITE_BUFFER, allocation.offset, (GLsizeiptr)bytes,
+            GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        if (!allocation.data) return StreamAllocation();
+    }
+    head = start + bytes;
+    return allocation;
+}
+
+void StreamBuffer::commit(const StreamAllocation& allocation) {
+    // Coherent mappings need nothing
+    if (mapped || !allocation) return;
+    glBindBuffer(GL_COPY_WRITE_BUFFER, allocation.buffer);
+    glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
+
+void StreamBuffer::endFrame() {
+    if (!buffer) return;
+    fences[current] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    lastUsed = head;
+    current = (current + 1) % Regions;
+}
+
+std::size_t StreamBuffer::alignmentFor(GLenum target) const {
+    if (target == GL_UNIFORM_BUFFER) return uniformAlignment;
+    if (target == GL_SHADER_STORAGE_BUFFER) return storageAlignment;
+    return 16;
+}
@@ -0,0 +1,83 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <glad/glad.h>
+
+// Where a per-frame allocation landed
+struct StreamAllocation {
+    void* data = nullptr;  // write here, then commit()
+    GLuint buffer = 0;
+    GLintptr offset = 0;   // bytes into buffer
+    std::size_t size = 0;
+
+    explicit operator bool() const { return data != nullptr; }
+};
+
+// Ring buffer for data the CPU rewrites every frame (instance transforms,
+// uniform blocks, indirect commands). One buffer is split into three
+// frame regions; allocations bump through the current one and a fence
+// after the frame's last draw guards it, so by the time the ring comes
+// back round the GPU has normally long finished and nothing waits.
+//
+// With GL 4.4 or ARB_buffer_storage the buffer is mapped once, persistent
+// and coherent, and callers write straight into it. Otherwise each
+// allocation is mapped unsynchronized (safe, as the fence already
+// covered the region) and commit() unmaps it; still no copy in the driver
+// and no implicit sync.
+//
+// A frame that runs out of room gets empty allocations (callers keep
+// their own upload path for that) and the ring grows at the next
+// beginFrame().
+class StreamBuffer {
+public:
+    static constexpr int Regions = 3;
+
+    void create(std::size_t bytesPerFrame);
+    void Delete();
+
+    // Waits for the GPU to release this frame's region
+    void beginFrame();
+    // Offset is a multiple of alignment (a power of two)
+    StreamAllocation allocate(std::size_t bytes, std::size_t alignment = 16);
+    // Makes the written data visible to GL; call before any draw reads it
+    // and before the next allocate(), as without persistent mapping only
+    // one allocation can be mapped at a time
+    void commit(const StreamAllocation& allocation);
+    // Fences the region; call after the last GL call reading this frame's data
+    void endFrame();
+
+    // Offset alignment a buffer binding target requires (uniform and
+    // storage ranges); 16 for anything else
+    std::size_t alignmentFor(GLenum target) const;
+
+    GLuint id() const { return buffer; }
+    bool persistent() const { return mapped != nullptr; }
+    std::size_t regionSize() const { return region; }
+    // Of the last finished frame
+    std::size_t bytesUsed() const { return lastUsed; }
+    // Whether the last beginFrame() found its region still in use by the GPU
+    bool stalled() const { return stalledLast; }
+
+private:
+    void allocateStorage();
+    void releaseStorage();
+
+    GLuint buffer = 0;
+    unsigned char* mapped = nullptr; // persistent mapping, all regions
+    GLsync fences[Regions] = {};
+    std::size_t region = 0;
+    int current = 0;
+    std::size_t head = 0;        // into the current region
+    std::size_t requested = 0;   // this frame, including what did not fit
+    std::size_t lastUsed = 0;
+    bool overflowed = false;
+    bool stalledLast = false;
+    std::size_t uniformAlignment = 256;
+    std::size_t storageAlignment = 256;
+};
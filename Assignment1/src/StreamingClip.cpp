@@ -0,0 +1,110 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#include "StreamingClip.h"
+
+#include <algorithm>
+#include <iostream>
+
+bool StreamingClip::open(const std::string& path) {
+    close();
+    if (!file.open(path)) return false;
+    if (!readClipHeader(file, header)) {
+        std::cerr << "[Clip] " << path << " is not a version " << CompressedClip::Version
+                  << " clip" << std::endl;
+        close();
+        return false;
+    }
+    return true;
+}
+
+void StreamingClip::close() {
+    file.close();
+    header = ClipFileHeader();
+    slots = {};
+    useClock = 0;
+    loads = 0;
+}
+
+std::size_t StreamingClip::residentBytes() const {
+    std::size_t bytes = 0;
+    for (const Slot& slot : slots) bytes += slot.keys.byteSize();
+    return bytes;
+}
+
+std::size_t StreamingClip::findChunk(float time, std::size_t hint) const {
+    const std::size_t last = header.chunkCount - 1;
+    auto contains = [&](std::size_t c) {
+        ClipChunkEntry entry;
+        readClipChunkEntry(file, c, entry);
+        return time >= entry.startTime && (c == last || time < entry.endTime);
+    };
+
+    // Same chunk, or the next one; otherwise binary search the table,
+    // which only touches a few of its pages
+    if (hint <= last && contains(hint)) return hint;
+    if (hint < last && contains(hint + 1)) return hint + 1;
+
+    std::size_t lo = 0, hi = last; // last chunk starting at or before time
+    while (lo < hi) {
+        std::size_t mid = (lo + hi + 1) / 2;
+        ClipChunkEntry entry;
+        readClipChunkEntry(file, mid, entry);
+        if (entry.startTime <= time) lo = mid;
+        else hi = mid - 1;
+    }
+    return lo;
+}
+
+const CompressedClip& StreamingClip::fetch(std::size_t chunk) {
+    ++useClock;
+    Slot* victim = &slots[0];
+    for (Slot& slot : slots) {
+        if (slot.chunk == chunk) {
+            slot.lastUse = useClock;
+            return slot.keys;
+        }
+        if (slot.lastUse < victim->lastUse) victim = &slot;
+    }
+
+    // Decode into the least recently used slot, then let the OS drop the
+    // file pages: the decoded copy is all playback needs. A chunk that
+    // fails to decode leaves the slot empty, so it is tried again.
+    ClipChunkEntry entry;
+    victim->lastUse = useClock;
+    if (!readClipChunkEntry(file, chunk, entry) ||
+        !victim->keys.readChunk(file.data() + entry.offset, entry.size)) {
+        std::cerr << "[Clip] Chunk " << chunk << " is corrupt" << std::endl;
+        victim->chunk = SIZE_MAX;
+        victim->keys = CompressedClip();
+        return victim->keys;
+    }
+    victim->chunk = chunk;
+    file.discard(entry.offset, entry.size);
+    ++loads;
+    return victim->keys;
+}
+
+void StreamingClip::sample(float time, ClipCursor& cursor, glm::vec3& position,
+    glm::quat& rotation) {
+    if (!isOpen()) {
+        position = glm::vec3(0.0f);
+        rotation = glm::quat(1, 0, 0, 0);
+        return;
+    }
+
+    time = glm::clamp(time, startTime(), endTime());
+    std::size_t chunk = findChunk(time, cursor.chunk);
+    if (chunk != cursor.chunk) {
+        cursor.chunk = chunk;
+        cursor.key = 0;
+    }
+    const CompressedClip& keys = fetch(chunk);
+    keys.sample(time, cursor.key, position, rotation);
+
+    // Page in the next chunk before the cursor gets there
+    if (chunk + 1 < header.chunkCount && cursor.key * 4 >= keys.keyCount() * 3) fetch(chunk + 1);
+}
@@ -0,0 +1,72 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include "CompressedClip.h"
+#include "FileUtils.h"
+
+// Playback position in a streamed clip: chunk, then key pair within it
+struct ClipCursor {
+    std::size_t chunk = 0;
+    std::size_t key = 0;
+};
+
+// Plays a .rclip straight from a memory mapping. Only the header is read
+// up front; chunks are decoded into a small LRU cache as the cursor
+// reaches them and their file pages are released again, so memory use
+// depends on the cache size, not on the clip length.
+class StreamingClip {
+public:
+    // Current chunk, the one prefetched after it and room for a scrub
+    static constexpr std::size_t CacheSlots = 4;
+
+    StreamingClip() = default;
+    explicit StreamingClip(const std::string& path) { open(path); }
+
+    bool open(const std::string& path);
+    void close();
+
+    bool isOpen() const { return file.isOpen(); }
+    float startTime() const { return header.startTime; }
+    float endTime() const { return header.endTime; }
+    float duration() const { return header.endTime - header.startTime; }
+    std::size_t keyCount() const { return header.keyCount; }
+    std::size_t chunkCount() const { return header.chunkCount; }
+
+    // Interpolated pose at time, clamped to the clip. Forward playback
+    // stays in the cursor's chunk or steps to the next one; the next
+    // chunk is decoded ahead once the cursor is three quarters through.
+    void sample(float time, ClipCursor& cursor, glm::vec3& position, glm::quat& rotation);
+
+    // Decoded key data held by the cache
+    std::size_t residentBytes() const;
+    // Chunks decoded since open
+    std::size_t chunkLoads() const { return loads; }
+
+private:
+    struct Slot {
+        std::size_t chunk = SIZE_MAX;
+        std::uint64_t lastUse = 0;
+        CompressedClip keys;
+    };
+
+    std::size_t findChunk(float time, std::size_t hint) const;
+    const CompressedClip& fetch(std::size_t chunk);
+
+    MappedFile file;
+    ClipFileHeader header = {};
+    std::array<Slot, CacheSlots> slots;
+    std::uint64_t useClock = 0;
+    std::size_t loads = 0;
+};
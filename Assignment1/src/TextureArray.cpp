@@ -0,0 +1,82 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#include "TextureArray.h"
+
+#include <algorithm>
+#include <iostream>
+#include <stb/stb_image.h>
+
+#include "ImageDecode.h"
+
+TextureArray::TextureArray(ThreadPool& pool) : workers(pool) {}
+
+TextureArray::~TextureArray() {
+    // Decode jobs write into our layers
+    workers.wait();
+    for (auto& layer : layers)
+        if (layer->pixels) stbi_image_free(layer->pixels);
+}
+
+void TextureArray::load(const std::vector<std::string>& paths) {
+    if (requested()) return;
+    for (const std::string& path : paths) {
+        layers.push_back(std::make_unique<Layer>());
+        Layer* layer = layers.back().get();
+        layer->path = path;
+        workers.submit([layer] {
+            layer->pixels = decodeImageRgba(layer->path, layer->width, layer->height);
+            if (!layer->pixels)
+                std::cerr << "[Texture] Failed to load " << layer->path << ": " << stbi_failure_reason() << std::endl;
+            layer->decoded = true;
+        });
+    }
+}
+
+void TextureArray::update() {
+    if (ready() || !requested()) return;
+    for (const auto& layer : layers)
+        if (!layer->decoded) return;
+
+    int width = 1, height = 1;
+    for (const auto& layer : layers) {
+        if (!layer->pixels) continue;
+        width = layer->width;
+        height = layer->height;
+        break;
+    }
+    int levels = 1;
+    while ((std::max(width, height) >> levels) > 0) levels++;
+
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, texture);
+    glTexStorage3D(GL_TEXTURE_2D_ARRAY, levels, GL_RGBA8, width, height, (GLsizei)layers.size());
+    std::vector<unsigned char> grey;
+    for (std::size_t i = 0; i < layers.size(); ++i) {
+        Layer& layer = *layers[i];
+        const unsigned char* pixels = layer.pixels;
+        if (!pixels || layer.width != width || layer.height != height) {
+            if (pixels) std::cerr << "[Texture] " << layer.path << " does not match the array size" << std::endl;
+            grey.assign((std::size_t)width * height * 4, 128);
+            pixels = grey.data();
+        }
+        glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, (GLint)i, width, height, 1,
+            GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+        if (layer.pixels) stbi_image_free(layer.pixels);
+        layer.pixels = nullptr;
+    }
+    glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+}
+
+void TextureArray::Delete() {
+    if (texture) glDeleteTextures(1, &texture);
+    texture = 0;
+}
@@ -0,0 +1,54 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+#include <glad/glad.h>
+
+#include "ThreadPool.h"
+
+// GL_TEXTURE_2D_ARRAY with one image file per layer. The files decode on
+// the thread pool; once every one is in, the layers are uploaded (RGBA8,
+// mipmapped) in one go and ready() turns true. Layers take the size of the
+// first image; one that differs (or fails to load) is filled mid grey.
+// Uses immutable storage (GL 4.2), so only for the GL 4.3 batch path.
+class TextureArray {
+public:
+    explicit TextureArray(ThreadPool& pool);
+    ~TextureArray();
+
+    TextureArray(const TextureArray&) = delete;
+    TextureArray& operator=(const TextureArray&) = delete;
+
+    // Starts decoding; only the first call does anything
+    void load(const std::vector<std::string>& paths);
+    bool requested() const { return !layers.empty(); }
+
+    // Uploads once everything has decoded; GL thread, once per frame
+    void update();
+    bool ready() const { return texture != 0; }
+
+    GLuint id() const { return texture; }
+    int layerCount() const { return (int)layers.size(); }
+
+    void Delete();
+
+private:
+    struct Layer {
+        std::string path;
+        unsigned char* pixels = nullptr;
+        int width = 0, height = 0;
+        std::atomic<bool> decoded{ false };
+    };
+
+    ThreadPool& workers;
+    std::vector<std::unique_ptr<Layer>> layers;
+    GLuint texture = 0;
+};
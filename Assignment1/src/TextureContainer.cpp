@@ -0,0 +1,238 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#include "TextureContainer.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "FileUtils.h"
+
+namespace {
+
+struct ContainerHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t format;
+    std::uint32_t width;
+    std::uint32_t height;
+    std::uint32_t levelCount;
+    std::uint32_t reserved;
+};
+
+const char ContainerMagic[8] = { 'R', 'T', 'A', 'T', 'E', 'X', '\0', '\0' };
+const std::uint32_t ContainerVersion = 1;
+
+std::size_t alignUp(std::size_t value, std::size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+// One BC4 block from 16 single-channel texels
+void encodeBC4Block(const unsigned char texels[16], unsigned char out[8]) {
+    unsigned char lo = 255, hi = 0;
+    for (int i = 0; i < 16; ++i) {
+        lo = std::min(lo, texels[i]);
+        hi = std::max(hi, texels[i]);
+    }
+
+    // red0 > red1 selects the 8-value interpolation mode
+    out[0] = hi;
+    out[1] = lo;
+    std::uint64_t bits = 0;
+    if (hi != lo) {
+        for (int i = 0; i < 16; ++i) {
+            // Position along hi -> lo in sevenths
+            int step = (int)((float)(hi - texels[i]) * 7.0f / (float)(hi - lo) + 0.5f);
+            // Palette order is: hi, lo, then the six blends from hi to lo
+            int index = step == 0 ? 0 : step == 7 ? 1 : step + 1;
+            bits |= (std::uint64_t)index << (3 * i);
+        }
+    }
+    for (int b = 0; b < 6; ++b) out[2 + b] = (unsigned char)(bits >> (8 * b));
+}
+
+// Block-compresses one channel of an image, clamping at the edges
+void encodeBC4Channel(const Image& img, int channel, int stride,
+    std::vector<unsigned char>& out, std::size_t blockOffset) {
+    int blocksX = (img.width + 3) / 4;
+    int blocksY = (img.height + 3) / 4;
+    unsigned char texels[16];
+
+    for (int by = 0; by < blocksY; ++by) {
+        for (int bx = 0; bx < blocksX; ++bx) {
+            for (int y = 0; y < 4; ++y) {
+                for (int x = 0; x < 4; ++x) {
+                    int px = std::min(bx * 4 + x, img.width - 1);
+                    int py = std::min(by * 4 + y, img.height - 1);
+                    texels[y * 4 + x] = img.pixels[((std::size_t)py * img.width + px) * img.channels + channel];
+                }
+            }
+            std::size_t block = (std::size_t)by * blocksX + bx;
+            encodeBC4Block(texels, &out[block * stride + blockOffset]);
+        }
+    }
+}
+
+} // namespace
+
+std::uint64_t TextureContainer::totalBytes() const {
+    std::uint64_t total = 0;
+    for (const TextureLevel& level : levels) total += level.size;
+    return total;
+}
+
+bool parseTextureContainer(const unsigned char* bytes, std::size_t size, TextureContainer& out) {
+    ContainerHeader header;
+    if (!bytes || size < sizeof(header)) return false;
+    std::memcpy(&header, bytes, sizeof(header));
+
+    if (std::memcmp(header.magic, ContainerMagic, sizeof(ContainerMagic)) != 0 ||
+        header.version != ContainerVersion || header.format > (std::uint32_t)TexelFormat::BC5 ||
+        header.levelCount == 0 || header.levelCount > 32)
+        return false;
+
+    std::size_t tableBytes = header.levelCount * sizeof(TextureLevel);
+    if (sizeof(header) + tableBytes > size) return false;
+
+    out.format = (TexelFormat)header.format;
+    out.levels.resize(header.levelCount);
+    std::memcpy(out.levels.data(), bytes + sizeof(header), tableBytes);
+    out.bytes = bytes;
+
+    for (const TextureLevel& level : out.levels)
+        if (level.offset + level.size > size) return false;
+    return true;
+}
+
+bool writeTextureContainer(const std::string& path, TexelFormat format, const std::vector<Image>& mips) {
+    if (mips.empty()) return false;
+
+    ContainerHeader header = {};
+    std::memcpy(header.magic, ContainerMagic, sizeof(ContainerMagic));
+    header.version = ContainerVersion;
+    header.format = (std::uint32_t)format;
+    header.width = (std::uint32_t)mips[0].width;
+    header.height = (std::uint32_t)mips[0].height;
+    header.levelCount = (std::uint32_t)mips.size();
+
+    std::vector<std::vector<unsigned char>> encoded;
+    std::vector<TextureLevel> table(mips.size());
+    std::size_t offset = alignUp(sizeof(header) + table.size() * sizeof(TextureLevel), 16);
+    for (std::size_t i = 0; i < mips.size(); ++i) {
+        encoded.push_back(encodeLevel(mips[i], format));
+        table[i] = { (std::uint32_t)mips[i].width, (std::uint32_t)mips[i].height,
+            offset, encoded.back().size() };
+        offset = alignUp(offset + encoded.back().size(), 16);
+    }
+
+    std::vector<unsigned char> bytes(offset, 0);
+    std::memcpy(bytes.data(), &header, sizeof(header));
+    std::memcpy(bytes.data() + sizeof(header), table.data(), table.size() * sizeof(TextureLevel));
+    for (std::size_t i = 0; i < encoded.size(); ++i)
+        std::memcpy(bytes.data() + table[i].offset, encoded[i].data(), encoded[i].size());
+
+    return writeFileAtomic(path, bytes.data(), bytes.size());
+}
+
+bool texelFormatFromName(const std::string& name, TexelFormat& out) {
+    static const TexelFormat all[] = { TexelFormat::RGBA8, TexelFormat::R8,
+        TexelFormat::RG8, TexelFormat::BC4, TexelFormat::BC5 };
+    for (TexelFormat f : all) {
+        if (name == texelFormatName(f)) { out = f; return true; }
+    }
+    return false;
+}
+
+const char* texelFormatName(TexelFormat format) {
+    switch (format) {
+    case TexelFormat::RGBA8: return "rgba8";
+    case TexelFormat::R8:    return "r8";
+    case TexelFormat::RG8:   return "rg8";
+    case TexelFormat::BC4:   return "bc4";
+    case TexelFormat::BC5:   return "bc5";
+    }
+    return "unknown";
+}
+
+int texelFormatChannels(TexelFormat format) {
+    switch (format) {
+    case TexelFormat::R8:
+    case TexelFormat::BC4: return 1;
+    case TexelFormat::RG8:
+    case TexelFormat::BC5: return 2;
+    default:               return 4;
+    }
+}
+
+bool isBlockCompressed(TexelFormat format) {
+    return format == TexelFormat::BC4 || format == TexelFormat::BC5;
+}
+
+std::size_t levelByteSize(TexelFormat format, int width, int height) {
+    std::size_t blocks = (std::size_t)((width + 3) / 4) * ((height + 3) / 4);
+    switch (format) {
+    case TexelFormat::BC4: return blocks * 8;
+    case TexelFormat::BC5: return blocks * 16;
+    default: return (std::size_t)width * height * texelFormatChannels(format);
+    }
+}
+
+Image extractChannels(const Image& src, int channels) {
+    Image out;
+    out.width = src.width;
+    out.height = src.height;
+    out.channels = channels;
+    out.pixels.resize((std::size_t)src.width * src.height * channels);
+
+    for (std::size_t p = 0; p < (std::size_t)src.width * src.height; ++p)
+        for (int c = 0; c < channels; ++c)
+            out.pixels[p * channels + c] = c < src.channels ? src.pixels[p * src.channels + c] : 255;
+    return out;
+}
+
+std::vector<Image> buildMipChain(const Image& base) {
+    std::vector<Image> chain{ base };
+    while (chain.back().width > 1 || chain.back().height > 1) {
+        const Image& src = chain.back();
+        Image dst;
+        dst.width = std::max(src.width / 2, 1);
+        dst.height = std::max(src.height / 2, 1);
+        dst.channels = src.channels;
+        dst.pixels.resize((std::size_t)dst.width * dst.height * dst.channels);
+
+        // Average the 2x2 footprint (clamped for odd or 1-wide levels)
+        for (int y = 0; y < dst.height; ++y) {
+            int y0 = std::min(y * 2, src.height - 1), y1 = std::min(y * 2 + 1, src.height - 1);
+            for (int x = 0; x < dst.width; ++x) {
+                int x0 = std::min(x * 2, src.width - 1), x1 = std::min(x * 2 + 1, src.width - 1);
+                for (int c = 0; c < dst.channels; ++c) {
+                    auto at = [&](int sx, int sy) {
+                        return (int)src.pixels[((std::size_t)sy * src.width + sx) * src.channels + c];
+                    };
+                    int sum = at(x0, y0) + at(x1, y0) + at(x0, y1) + at(x1, y1);
+                    dst.pixels[((std::size_t)y * dst.width + x) * dst.channels + c] = (unsigned char)((sum + 2) / 4);
+                }
+            }
+        }
+        chain.push_back(std::move(dst));
+    }
+    return chain;
+}
+
+std::vector<unsigned char> encodeLevel(const Image& level, TexelFormat format) {
+    std::vector<unsigned char> out(levelByteSize(format, level.width, level.height));
+    if (format == TexelFormat::BC4) {
+        encodeBC4Channel(level, 0, 8, out, 0);
+    } else if (format == TexelFormat::BC5) {
+        // BC5 is a red BC4 block followed by a green one
+        encodeBC4Channel(level, 0, 16, out, 0);
+        encodeBC4Channel(level, 1, 16, out, 8);
+    } else {
+        Image plain = extractChannels(level, texelFormatChannels(format));
+        std::memcpy(out.data(), plain.pixels.data(), out.size());
+    }
+    return out;
+}
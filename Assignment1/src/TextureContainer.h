@@ -0,0 +1,62 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Baked texture container (.rtex): a small header, a level table and the
+// full mip chain already in its GPU format, so loading is a straight copy.
+enum class TexelFormat : std::uint32_t {
+    RGBA8 = 0,
+    R8 = 1,
+    RG8 = 2,
+    BC4 = 3, // RGTC1, one channel at 4 bpp
+    BC5 = 4  // RGTC2, two channels at 8 bpp
+};
+
+struct TextureLevel {
+    std::uint32_t width;
+    std::uint32_t height;
+    std::uint64_t offset; // from the start of the file
+    std::uint64_t size;
+};
+
+// Parsed view over a container's bytes (usually a MappedFile)
+struct TextureContainer {
+    TexelFormat format = TexelFormat::RGBA8;
+    std::vector<TextureLevel> levels;
+    const unsigned char* bytes = nullptr;
+
+    std::uint64_t totalBytes() const;
+};
+
+// Decoded 8-bit image, channels interleaved
+struct Image {
+    int width = 0;
+    int height = 0;
+    int channels = 0;
+    std::vector<unsigned char> pixels;
+};
+
+bool parseTextureContainer(const unsigned char* bytes, std::size_t size, TextureContainer& out);
+bool writeTextureContainer(const std::string& path, TexelFormat format, const std::vector<Image>& mips);
+
+bool texelFormatFromName(const std::string& name, TexelFormat& out);
+const char* texelFormatName(TexelFormat format);
+int texelFormatChannels(TexelFormat format);
+bool isBlockCompressed(TexelFormat format);
+std::size_t levelByteSize(TexelFormat format, int width, int height);
+
+// Keeps the first `channels` channels of an image
+Image extractChannels(const Image& src, int channels);
+// 2x2 box-filtered chain down to 1x1, starting with base itself
+std::vector<Image> buildMipChain(const Image& base);
+// Converts one level into the bytes stored for format
+std::vector<unsigned char> encodeLevel(const Image& level, TexelFormat format);
@@ -0,0 +1,225 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#include "TextureStreamer.h"
+
+#include <cstring>
+#include <iostream>
+#include <stb/stb_image.h>
+
+#include "ImageDecode.h"
+
+TextureStreamer::TextureStreamer(ThreadPool& pool) : workers(pool) {}
+
+TextureStreamer::~TextureStreamer() {
+    // Jobs reference our state, so let in-flight work finish first
+    workers.wait();
+    for (auto& job : jobs)
+        if (job->pixels) stbi_image_free(job->pixels);
+}
+
+GLuint TextureStreamer::request(const std::string& path, const glm::vec4& placeholder) {
+    GLuint texture = 0;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+
+    unsigned char texel[4];
+    for (int c = 0; c < 4; ++c)
+        texel[c] = (unsigned char)(glm::clamp(placeholder[c], 0.0f, 1.0f) * 255.0f + 0.5f);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, texel);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glGenerateMipmap(GL_TEXTURE_2D);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    textures.push_back(texture);
+
+    jobs.push_back(std::make_unique<Job>());
+    Job& job = *jobs.back();
+    job.path = path;
+    job.texture = texture;
+    job.requested = std::chrono::steady_clock::now();
+    ++outstanding;
+
+    // Prefer the baked container when the bake step has produced one
+    std::string baked = path.substr(0, path.find_last_of('.')) + ".rtex";
+    if (fileSize(baked) > 0) {
+        job.path = baked;
+        job.baked = true;
+    }
+
+    workers.submit([this, &job] { decode(job); });
+    return texture;
+}
+
+void TextureStreamer::decode(Job& job) {
+    if (job.baked) {
+        // Nothing to decode: map the file and validate its level table
+        if (!job.container.open(job.path) ||
+            !parseTextureContainer(job.container.data(), job.container.size(), job.layout)) {
+            std::cerr << "[Texture] Invalid container " << job.path << std::endl;
+            job.stage = Stage::Failed;
+            return;
+        }
+        job.width = (int)job.layout.levels[0].width;
+        job.height = (int)job.layout.levels[0].height;
+        job.bytes = (std::size_t)job.layout.totalBytes();
+        job.stage = Stage::Decoded;
+        return;
+    }
+
+    job.pixels = decodeImageRgba(job.path, job.width, job.height);
+    if (!job.pixels) {
+        std::cerr << "[Texture] Failed to load " << job.path << ": " << stbi_failure_reason() << std::endl;
+        job.stage = Stage::Failed;
+        return;
+    }
+    job.bytes = (std::size_t)job.width * job.height * 4;
+    job.stage = Stage::Decoded;
+}
+
+void TextureStreamer::copyToPbo(Job& job) {
+    unsigned char* dst = static_cast<unsigned char*>(job.mapped);
+    if (job.baked) {
+        // Levels are packed back to back in the PBO
+        for (const TextureLevel& level : job.layout.levels) {
+            std::memcpy(dst, job.layout.bytes + level.offset, (std::size_t)level.size);
+            dst += level.size;
+        }
+        job.container.close();
+    } else {
+        std::memcpy(dst, job.pixels, job.bytes);
+        stbi_image_free(job.pixels);
+        job.pixels = nullptr;
+    }
+    job.stage = Stage::Copied;
+}
+
+void TextureStreamer::update(std::size_t budgetBytes) {
+    std::size_t mappedBytes = 0;
+
+    for (auto& jobPtr : jobs) {
+        Job& job = *jobPtr;
+        switch (job.stage.load()) {
+        case Stage::Decoded: {
+            std::size_t bytes = job.bytes;
+            // Always let one through so huge images cannot starve
+            if (mappedBytes > 0 && mappedBytes + bytes > budgetBytes) break;
+            mappedBytes += bytes;
+
+            glGenBuffers(1, &job.pbo);
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, job.pbo);
+            glBufferData(GL_PIXEL_UNPACK_BUFFER, (GLsizeiptr)bytes, nullptr, GL_STREAM_DRAW);
+            job.mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, (GLsizeiptr)bytes,
+                GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+            if (!job.mapped) {
+                glDeleteBuffers(1, &job.pbo);
+                job.pbo = 0;
+                job.stage = Stage::Failed;
+                break;
+            }
+
+            // The copy into driver memory happens off the GL thread
+            job.stage = Stage::Copying;
+            workers.submit([&job] { copyToPbo(job); });
+            break;
+        }
+        case Stage::Copied:
+            finishUpload(job);
+            job.stage = Stage::Done;
+            --outstanding;
+            break;
+        case Stage::Failed:
+            // Keep the placeholder, just stop tracking it
+            job.stage = Stage::Done;
+            --outstanding;
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+void TextureStreamer::finishUpload(Job& job) {
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, job.pbo);
+    glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+
+    // Source pointers are offsets into the bound PBO
+    glBindTexture(GL_TEXTURE_2D, job.texture);
+    if (job.baked) {
+        GLenum internalFormat = GL_RGBA8, format = GL_RGBA;
+        switch (job.layout.format) {
+        case TexelFormat::R8:  internalFormat = GL_R8;  format = GL_RED; break;
+        case TexelFormat::RG8: internalFormat = GL_RG8; format = GL_RG;  break;
+        case TexelFormat::BC4: internalFormat = GL_COMPRESSED_RED_RGTC1; break;
+        case TexelFormat::BC5: internalFormat = GL_COMPRESSED_RG_RGTC2;  break;
+        default: break;
+        }
+
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        std::size_t offset = 0;
+        for (std::size_t i = 0; i < job.layout.levels.size(); ++i) {
+            const TextureLevel& level = job.layout.levels[i];
+            if (isBlockCompressed(job.layout.format)) {
+                glCompressedTexImage2D(GL_TEXTURE_2D, (GLint)i, internalFormat, level.width, level.height,
+                    0, (GLsizei)level.size, (void*)offset);
+            } else {
+                glTexImage2D(GL_TEXTURE_2D, (GLint)i, (GLint)internalFormat, level.width, level.height,
+                    0, format, GL_UNSIGNED_BYTE, (void*)offset);
+            }
+            offset += (std::size_t)level.size;
+        }
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, (GLint)job.layout.levels.size() - 1);
+
+        // Single-channel maps read as grey, like the RGBA path
+        if (texelFormatChannels(job.layout.format) == 1) {
+            GLint swizzle[4] = { GL_RED, GL_RED, GL_RED, GL_ONE };
+            glTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_RGBA, swizzle);
+        }
+        resident += job.bytes;
+    } else {
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, job.width, job.height, 0,
+            GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        glGenerateMipmap(GL_TEXTURE_2D);
+        resident += job.bytes * 4 / 3;
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    // GL keeps the storage alive until the transfer has consumed it
+    glDeleteBuffers(1, &job.pbo);
+    job.pbo = 0;
+    job.mapped = nullptr;
+
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - job.requested).count();
+    std::cout << "[Texture] " << job.path << " (" << job.width << "x" << job.height << ", "
+              << (job.baked ? texelFormatName(job.layout.format) : "png rgba8") << ") ready after "
+              << ms << " ms\n";
+}
+
+void TextureStreamer::Delete() {
+    workers.wait();
+    for (auto& job : jobs) {
+        if (job->pbo) {
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, job->pbo);
+            if (job->mapped) glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            glDeleteBuffers(1, &job->pbo);
+        }
+        if (job->pixels) stbi_image_free(job->pixels);
+        job->pixels = nullptr;
+        job->container.close();
+    }
+    jobs.clear();
+    if (!textures.empty()) glDeleteTextures((GLsizei)textures.size(), textures.data());
+    textures.clear();
+    outstanding = 0;
+    resident = 0;
+}
@@ -0,0 +1,77 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include "FileUtils.h"
+#include "TextureContainer.h"
+#include "ThreadPool.h"
+
+// Loads textures without stalling the render loop:
+//   worker: read + decode the image file
+//   GL thread: map a pixel buffer object for it
+//   worker: copy the pixels into the mapped PBO
+//   GL thread: unmap, glTexImage2D from the PBO, build mips
+// Each texture is a 1x1 placeholder until its upload completes. When a baked
+// .rtex sits next to the requested image, its mapped mip chain is copied
+// instead and no decoding or mip generation happens at all.
+class TextureStreamer {
+public:
+    explicit TextureStreamer(ThreadPool& pool);
+    ~TextureStreamer();
+
+    // Returns a usable texture name immediately
+    GLuint request(const std::string& path, const glm::vec4& placeholder = glm::vec4(1.0f));
+
+    // Advances uploads; call once per frame on the GL thread. At most
+    // budgetBytes of new PBO storage is mapped per call.
+    void update(std::size_t budgetBytes = 16u << 20);
+
+    bool idle() const { return outstanding == 0; }
+    int pending() const { return outstanding; }
+    // Bytes of texture storage uploaded so far (including mips)
+    std::size_t residentBytes() const { return resident; }
+
+    // Frees every texture handed out by request()
+    void Delete();
+
+private:
+    enum class Stage { Decoding, Decoded, Copying, Copied, Done, Failed };
+
+    struct Job {
+        std::string path;
+        GLuint texture = 0;
+        GLuint pbo = 0;
+        int width = 0, height = 0;
+        unsigned char* pixels = nullptr; // decoder output
+        bool baked = false;
+        MappedFile container;            // baked .rtex, mapped by a worker
+        TextureContainer layout;
+        std::size_t bytes = 0;           // total upload size
+        void* mapped = nullptr;          // PBO mapping, written by a worker
+        std::chrono::steady_clock::time_point requested;
+        std::atomic<Stage> stage{ Stage::Decoding };
+    };
+
+    void decode(Job& job);
+    static void copyToPbo(Job& job);
+    void finishUpload(Job& job);
+
+    ThreadPool& workers;
+    std::vector<std::unique_ptr<Job>> jobs;
+    std::vector<GLuint> textures;
+    int outstanding = 0;
+    std::size_t resident = 0;
+};
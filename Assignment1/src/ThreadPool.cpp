@@ -0,0 +1,98 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+ThreadPool::ThreadPool(unsigned workers) {
+    if (workers == 0) {
+        unsigned hw = std::thread::hardware_concurrency();
+        workers = std::max(hw, 2u) - 1;
+    }
+    for (unsigned i = 0; i < workers; ++i)
+        threads.emplace_back(&ThreadPool::workerLoop, this);
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    jobReady.notify_all();
+    for (std::thread& t : threads) t.join();
+}
+
+void ThreadPool::submit(std::function<void()> job) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        jobs.push_back(std::move(job));
+    }
+    jobReady.notify_one();
+}
+
+void ThreadPool::wait() {
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [this] { return jobs.empty() && running == 0; });
+}
+
+void ThreadPool::parallelFor(std::size_t count,
+    const std::function<void(std::size_t, std::size_t)>& body) {
+    if (count == 0) return;
+    // A few chunks per thread so uneven chunks even out
+    const std::size_t chunkCount = std::min(count, (std::size_t)(threads.size() + 1) * 4);
+    const std::size_t chunkSize = (count + chunkCount - 1) / chunkCount;
+
+    // Helpers may start after the caller has returned, so everything they
+    // touch is shared; late ones find no chunks left and never call body
+    struct Loop {
+        std::atomic<std::size_t> next{ 0 };
+        std::size_t finished = 0;
+        std::mutex mutex;
+        std::condition_variable done;
+    };
+    auto loop = std::make_shared<Loop>();
+    const std::size_t chunks = (count + chunkSize - 1) / chunkSize;
+    auto run = [loop, chunks, chunkSize, count, &body] {
+        for (;;) {
+            std::size_t chunk = loop->next++;
+            if (chunk >= chunks) return;
+            std::size_t begin = chunk * chunkSize;
+            body(begin, std::min(begin + chunkSize, count));
+            std::lock_guard<std::mutex> lock(loop->mutex);
+            if (++loop->finished == chunks) loop->done.notify_all();
+        }
+    };
+    for (std::size_t i = 1; i < std::min(chunks, threads.size() + 1); ++i) submit(run);
+    run();
+
+    std::unique_lock<std::mutex> lock(loop->mutex);
+    loop->done.wait(lock, [&] { return loop->finished == chunks; });
+}
+
+void ThreadPool::workerLoop() {
+    for (;;) {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            jobReady.wait(lock, [this] { return stopping || !jobs.empty(); });
+            if (stopping && jobs.empty()) return;
+            job = std::move(jobs.front());
+            jobs.pop_front();
+            ++running;
+        }
+
+        job();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            --running;
+            if (jobs.empty() && running == 0) idle.notify_all();
+        }
+    }
+}
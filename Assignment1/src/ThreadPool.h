@@ -0,0 +1,47 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads pulling jobs from one FIFO queue
+class ThreadPool {
+public:
+    // 0 picks one worker per hardware thread, minus the render thread
+    explicit ThreadPool(unsigned workers = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void submit(std::function<void()> job);
+    // Blocks until the queue is empty and no job is running
+    void wait();
+
+    // Runs body over [0, count) split into chunks, on the workers and the
+    // calling thread, and returns once every chunk is done. Only waits for
+    // its own chunks, not for other queued jobs.
+    void parallelFor(std::size_t count, const std::function<void(std::size_t, std::size_t)>& body);
+
+    unsigned size() const { return (unsigned)threads.size(); }
+
+private:
+    void workerLoop();
+
+    std::vector<std::thread> threads;
+    std::deque<std::function<void()>> jobs;
+    std::mutex mutex;
+    std::condition_variable jobReady;
+    std::condition_variable idle;
+    unsigned running = 0;
+    bool stopping = false;
+};
@@ -0,0 +1,39 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#include "Transform.h"
+
+#include <engine/MathUtils.h>
+#include <glm/gtc/matrix_transform.hpp>
+
+glm::mat4 Transform::matrix() const {
+    glm::mat4 m = glm::translate(glm::mat4(1.0f), position) * glm::mat4_cast(rotation);
+    return glm::scale(m, scale);
+}
+
+glm::mat3 Transform::normalMatrix() const {
+    // R * S^-1: avoids a general 3x3 inverse since R is orthonormal
+    glm::mat3 r = glm::mat3_cast(rotation);
+    r[0] /= scale.x;
+    r[1] /= scale.y;
+    r[2] /= scale.z;
+    return r;
+}
+
+Transform interpolate(const Transform& a, const Transform& b, float t) {
+    Transform out;
+    out.position = glm::mix(a.position, b.position, t);
+    out.rotation = MathUtils::slerp(a.rotation, b.rotation, t);
+    out.scale = glm::mix(a.scale, b.scale, t);
+    return out;
+}
+
+glm::quat eulerYXZToQuat(float pitchDeg, float yawDeg, float rollDeg) {
+    glm::quat qy = glm::angleAxis(glm::radians(yawDeg),   glm::vec3(0.0f, 1.0f, 0.0f));
+    glm::quat qx = glm::angleAxis(glm::radians(pitchDeg), glm::vec3(1.0f, 0.0f, 0.0f));
+    glm::quat qz = glm::angleAxis(glm::radians(rollDeg),  glm::vec3(0.0f, 0.0f, 1.0f));
+    return glm::normalize(qy * qx * qz);
+}
@@ -0,0 +1,28 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#pragma once
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+// App-side copy of an object's TRS, so matrices derived from it (like the
+// normal matrix) can be computed on the CPU once per object per frame
+struct Transform {
+    glm::vec3 position = glm::vec3(0.0f);
+    glm::quat rotation = glm::quat(1, 0, 0, 0);
+    glm::vec3 scale = glm::vec3(1.0f);
+
+    glm::mat4 matrix() const;
+    // transpose(inverse(mat3(model)))
+    glm::mat3 normalMatrix() const;
+};
+
+// Blend between two snapshots: lerp position/scale, slerp rotation
+Transform interpolate(const Transform& a, const Transform& b, float t);
+
+// Intrinsic yaw (Y), then pitch (X), then roll (Z): R = Ry * Rx * Rz
+glm::quat eulerYXZToQuat(float pitchDeg, float yawDeg, float rollDeg);
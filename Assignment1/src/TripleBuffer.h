@@ -0,0 +1,47 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#pragma once
+
+#include <atomic>
+
+// Single-producer / single-consumer handover without locks. The writer
+// fills back() and publish()es it; the reader calls update() and then
+// reads front(). Neither side ever waits: the writer always has a free
+// slot and the reader keeps the last published value until a newer one
+// arrives.
+template <typename T>
+class TripleBuffer {
+public:
+    // -------------------- Writer --------------------
+    T& back() { return slots[backIndex]; }
+
+    void publish() {
+        unsigned previous = middle.exchange(backIndex | FreshBit, std::memory_order_acq_rel);
+        backIndex = previous & IndexMask;
+    }
+
+    // -------------------- Reader --------------------
+    // Swap in the newest published slot; false if nothing new
+    bool update() {
+        if (!(middle.load(std::memory_order_acquire) & FreshBit)) return false;
+        unsigned previous = middle.exchange(frontIndex, std::memory_order_acq_rel);
+        frontIndex = previous & IndexMask;
+        return true;
+    }
+
+    const T& front() const { return slots[frontIndex]; }
+
+private:
+    static constexpr unsigned IndexMask = 3;
+    static constexpr unsigned FreshBit = 4;
+
+    T slots[3] = {};
+    // Writer and reader indices on their own cache lines
+    alignas(64) std::atomic<unsigned> middle{ 1 };
+    alignas(64) unsigned backIndex = 0;
+    alignas(64) unsigned frontIndex = 2;
+};
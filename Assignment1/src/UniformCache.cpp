@@ -0,0 +1,48 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#include "UniformCache.h"
+
+#include <vector>
+
+void UniformCache::build(GLuint program) {
+    programId = program;
+    locations.clear();
+
+    GLint count = 0, maxLength = 0;
+    glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+    std::vector<char> name((std::size_t)maxLength + 1);
+
+    for (GLint i = 0; i < count; ++i) {
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        glGetActiveUniform(program, (GLuint)i, (GLsizei)name.size(), &length, &size, &type, name.data());
+        std::string key(name.data(), (std::size_t)length);
+
+        // Block members report no location; skip them
+        GLint loc = glGetUniformLocation(program, key.c_str());
+        if (loc < 0) continue;
+
+        // Arrays are reported as "name[0]", also register the bare name
+        locations[key] = loc;
+        std::size_t bracket = key.find('[');
+        if (bracket != std::string::npos) locations[key.substr(0, bracket)] = loc;
+    }
+}
+
+GLint UniformCache::location(const std::string& name) const {
+    auto it = locations.find(name);
+    return it == locations.end() ? -1 : it->second;
+}
+
+bool UniformCache::bindBlock(const char* blockName, GLuint binding) const {
+    GLuint index = glGetUniformBlockIndex(programId, blockName);
+    if (index == GL_INVALID_INDEX) return false;
+    glUniformBlockBinding(programId, index, binding);
+    return true;
+}
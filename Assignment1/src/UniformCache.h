@@ -0,0 +1,40 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+// Every active uniform location of a linked program, enumerated once.
+// Lookups after that never reach the driver; hot paths keep the GLint.
+class UniformCache {
+public:
+    UniformCache() = default;
+    explicit UniformCache(GLuint program) { build(program); }
+
+    void build(GLuint program);
+    GLuint program() const { return programId; }
+
+    // -1 when the uniform is not active in the program
+    GLint location(const std::string& name) const;
+    // Points a uniform block at a shared binding point; false if the
+    // program has no such block
+    bool bindBlock(const char* blockName, GLuint binding) const;
+
+    // Setters for the currently bound program
+    static void set(GLint loc, int value) { if (loc >= 0) glUniform1i(loc, value); }
+    static void set(GLint loc, float value) { if (loc >= 0) glUniform1f(loc, value); }
+    static void set(GLint loc, const glm::vec3& v) { if (loc >= 0) glUniform3fv(loc, 1, &v.x); }
+    static void set(GLint loc, const glm::mat3& m) { if (loc >= 0) glUniformMatrix3fv(loc, 1, GL_FALSE, &m[0][0]); }
+    static void set(GLint loc, const glm::mat4& m) { if (loc >= 0) glUniformMatrix4fv(loc, 1, GL_FALSE, &m[0][0]); }
+
+private:
+    GLuint programId = 0;
+    std::unordered_map<std::string, GLint> locations;
+};
@@ -0,0 +1,65 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+// eulerToQuatBatch against glm's own per-axis quaternion products, for
+// every EulerOrder on every SIMD level this CPU runs. The count is not a
+// multiple of any lane width, so the scalar tails are covered too.
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include "BatchMath.h"
+
+// Left-to-right product of one rotation per axis, in the order given
+static glm::quat reference(const glm::vec3& eulerDeg, EulerOrder order) {
+    glm::quat qx = glm::angleAxis(glm::radians(eulerDeg.x), glm::vec3(1.0f, 0.0f, 0.0f));
+    glm::quat qy = glm::angleAxis(glm::radians(eulerDeg.y), glm::vec3(0.0f, 1.0f, 0.0f));
+    glm::quat qz = glm::angleAxis(glm::radians(eulerDeg.z), glm::vec3(0.0f, 0.0f, 1.0f));
+    switch (order) {
+    case EulerOrder::XYZ: return qx * qy * qz;
+    case EulerOrder::YXZ: return qy * qx * qz;
+    default:              return qz * qy * qx;
+    }
+}
+
+// Distance between two unit quaternions; q and -q are the same rotation
+static float quatError(const glm::quat& a, const glm::quat& b) {
+    glm::vec4 va(a.x, a.y, a.z, a.w), vb(b.x, b.y, b.z, b.w);
+    return std::min(glm::length(va - vb), glm::length(va + vb));
+}
+
+int main() {
+    const std::size_t count = 1037;
+    const float tolerance = 1e-5f;
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> angle(-180.0f, 180.0f);
+    Vec3Array eulers;
+    eulers.resize(count);
+    for (std::size_t i = 0; i < count; ++i) eulers.set(i, glm::vec3(angle(rng), angle(rng), angle(rng)));
+
+    const char* orderNames[3] = { "XYZ", "YXZ", "ZYX" };
+    int failures = 0;
+    QuatArray out;
+    for (SimdLevel level : { SimdLevel::Scalar, SimdLevel::Sse2, SimdLevel::Avx2 }) {
+        if ((int)level > (int)detectSimdLevel()) continue;
+        setSimdLevel(level);
+        for (int order = 0; order < 3; ++order) {
+            eulerToQuatBatch(eulers, (EulerOrder)order, out);
+            float maxError = 0.0f;
+            for (std::size_t i = 0; i < count; ++i)
+                maxError = std::max(maxError, quatError(out.get(i), reference(eulers.get(i), (EulerOrder)order)));
+            bool ok = maxError <= tolerance;
+            failures += !ok;
+            std::printf("[Test] eulerToQuatBatch %s %s: max error %g %s\n", simdLevelName(level),
+                orderNames[order], maxError, ok ? "ok" : "FAILED");
+        }
+    }
+    return failures == 0 ? 0 : 1;
+}
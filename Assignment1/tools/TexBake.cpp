@@ -0,0 +1,58 @@
+/*
+* Author: Priyansh Nayak
+* Project: Plane Rotation
+* Course: CS7GV5: Real-Time Animation
+*/
+
+// Offline texture baker: image file -> .rtex with a full mip chain.
+// Usage: texbake <input image> <output.rtex> [rgba8|r8|rg8|bc4|bc5]
+
+#include <iostream>
+#include <string>
+#include <stb/stb_image.h>
+
+#include "ImageDecode.h"
+#include "TextureContainer.h"
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::cerr << "Usage: texbake <input image> <output.rtex> [rgba8|r8|rg8|bc4|bc5]\n";
+        return 1;
+    }
+    std::string input = argv[1];
+    std::string output = argv[2];
+    TexelFormat format = TexelFormat::RGBA8;
+    if (argc > 3 && !texelFormatFromName(argv[3], format)) {
+        std::cerr << "[Bake] Unknown format " << argv[3] << "\n";
+        return 1;
+    }
+
+    // Same orientation the runtime PNG path uploads with
+    Image source;
+    unsigned char* pixels = decodeImageRgba(input, source.width, source.height);
+    if (!pixels) {
+        std::cerr << "[Bake] Failed to load " << input << ": " << stbi_failure_reason() << "\n";
+        return 1;
+    }
+    source.channels = 4;
+    source.pixels.assign(pixels, pixels + (std::size_t)source.width * source.height * 4);
+    stbi_image_free(pixels);
+
+    Image base = extractChannels(source, texelFormatChannels(format));
+    std::vector<Image> mips = buildMipChain(base);
+    if (!writeTextureContainer(output, format, mips)) {
+        std::cerr << "[Bake] Failed to write " << output << "\n";
+        return 1;
+    }
+
+    // Compare against what the PNG path keeps resident: RGBA8 plus mips
+    std::size_t baked = 0;
+    for (const Image& level : mips) baked += levelByteSize(format, level.width, level.height);
+    std::size_t runtime = (std::size_t)source.width * source.height * 4 * 4 / 3;
+
+    std::cout << "[Bake] " << input << " -> " << output << " (" << source.width << "x"
+              << source.height << " " << texelFormatName(format) << ", " << mips.size() << " levels)\n"
+              << "[Bake] VRAM " << runtime / 1024 << " KiB (PNG path) -> " << baked / 1024
+              << " KiB (" << (double)runtime / (double)baked << "x smaller)\n";
+    return 0;
+}